@@ -0,0 +1,129 @@
+// ActivitySet.cpp
+
+#include "ActivitySet.h"
+#include "Actor.h"
+#include "Dungeon.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+// ActivitySet default constructor
+ActivitySet::ActivitySet()
+{
+    m_valid = false;
+    m_version = 0;
+    m_travel = 0;
+    m_lastRow = 0;
+    m_lastCol = 0;
+}
+
+// Accessor: returns the monsters to visit this turn, in table order
+const std::vector<int>& ActivitySet::getVisits() const
+{
+    return(m_visits);
+}
+
+// Accessor: returns whether the Player was within the monster's reach at the last update
+bool ActivitySet::inReach(int index) const
+{
+    return(m_inReach[index] != 0);
+}
+
+// Accessor: returns the number of monsters put aside as out of reach
+int ActivitySet::getDormantCount() const
+{
+    return(static_cast<int>(m_dormant.size()));
+}
+
+// Mutator: works out which monsters to visit this turn, with the Player at the given cell
+void ActivitySet::update(const MonsterStats& stats, int prow, int pcol, unsigned version)
+{
+    if (!m_valid || version != m_version || stats.kind.size() != m_inReach.size())
+    {
+        rebuild(stats, version);
+    }
+    else
+    {
+        m_travel += std::abs(prow - m_lastRow) + std::abs(pcol - m_lastCol);
+    }
+
+    m_lastRow = prow;
+    m_lastCol = pcol;
+
+    // Wake the monsters the Player may now have come within reach of
+    while (!m_dormant.empty() && m_dormant.top().wakeAt <= m_travel)
+    {
+        m_near.push_back(m_dormant.top().index);
+        m_dormant.pop();
+    }
+
+    // Check the rest; any out of reach are put aside until the Player could close the gap
+    const int* rows = stats.row.data();
+    const int* cols = stats.col.data();
+    const int* reach = stats.reach.data();
+    size_t kept = 0;
+
+    for (size_t n = 0; n < m_near.size(); n++)
+    {
+        int i = m_near[n];
+        int distance = std::abs(rows[i] - prow) + std::abs(cols[i] - pcol);
+
+        if (distance <= reach[i])
+        {
+            m_inReach[i] = 1;
+            m_near[kept++] = i;
+        }
+        else
+        {
+            m_inReach[i] = 0;
+
+            Dormant dormant;
+            dormant.wakeAt = m_travel + (distance - reach[i]);
+            dormant.index = i;
+            m_dormant.push(dormant);
+        }
+    }
+    m_near.resize(kept);
+
+    // Visit the monsters within reach and every Dragon, in table order
+    std::sort(m_near.begin(), m_near.end());
+    m_visits.clear();
+    std::set_union(m_near.begin(), m_near.end(), m_dragons.begin(), m_dragons.end(),
+        std::back_inserter(m_visits));
+}
+
+// Mutator: rebuilds the set on the next update
+void ActivitySet::invalidate()
+{
+    m_valid = false;
+}
+
+// Private Helper Function: starts over, with every monster to be checked
+void ActivitySet::rebuild(const MonsterStats& stats, unsigned version)
+{
+    int count = static_cast<int>(stats.kind.size());
+
+    m_valid = true;
+    m_version = version;
+    m_travel = 0;
+    m_near.clear();
+    m_dragons.clear();
+    m_inReach.assign(count, 0);
+    m_dormant = std::priority_queue<Dormant, std::vector<Dormant>, std::greater<Dormant>>();
+
+    for (int i = 0; i < count; i++)
+    {
+        m_near.push_back(i);
+
+        if (stats.kind[i] == ActorKind::Dragon)
+        {
+            m_dragons.push_back(i);
+        }
+    }
+}
+
+// Returns whether this monster is due later than the other one
+bool ActivitySet::Dormant::operator>(const Dormant& other) const
+{
+    return(wakeAt > other.wakeAt);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+// ActivitySet.h
+
+#ifndef ACTIVITYSET_INCLUDED
+#define ACTIVITYSET_INCLUDED
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+/*
+ ActivitySet Design Notes:
+ - An ActivitySet tracks which of a Dungeon's monsters could act this turn, so that the
+   monsters' turn only visits those. A monster only acts while the Player is within its
+   reach (Manhattan distance), and a monster out of reach does not move, so the only way
+   it comes within reach is by the Player walking towards it.
+ - The set keeps a running total of how far the Player has travelled (the Manhattan length
+   of each turn's step, so a teleport counts its full jump). A monster found out of reach
+   by some margin cannot come within reach until the Player has travelled that margin
+   further, so it is put aside, dormant, until the total reaches that point; until then
+   it is never looked at. Dormant monsters wait in a queue ordered by that point, so each
+   turn only wakes the ones that are due.
+ - The monsters within reach are checked again every turn, as they (and the Player) move.
+ - Dragons roll to regenerate every turn wherever they are, and the rolls share the Game's
+   random sequence with the monsters' moves, so Dragons are visited every turn. The visits
+   are kept in table order, so every roll happens in the same order as before.
+ - The set is rebuilt from scratch whenever the monster table changes (a monster added or
+   removed, or a new level), which the Dungeon's monster version shows.
+*/
+
+struct MonsterStats; // Indicates to compiler that MonsterStats is a struct
+
+class ActivitySet
+{
+public:
+    // Constructors and Destructors
+    ActivitySet();
+
+    // Accessor Functions
+    const std::vector<int>& getVisits() const; // Retrieve this turn's monsters, in order
+    bool inReach(int index) const; // Retrieve whether the Player is within the reach
+    int getDormantCount() const; // Retrieve the number of monsters put aside
+
+    // Mutator Functions
+    void update(const MonsterStats& stats, int prow, int pcol, unsigned version);
+    void invalidate(); // Rebuilds the set on the next update (e.g. after a load)
+private:
+    // A monster put aside until the Player has travelled far enough to reach it
+    struct Dormant
+    {
+        long long wakeAt; // The travel total at which the Player could first reach it
+        int index; // The monster's row in the statistics table
+
+        bool operator>(const Dormant& other) const;
+    };
+
+    // Private Helper Functions
+    void rebuild(const MonsterStats& stats, unsigned version); // Starts over
+
+    bool m_valid; // Whether the set describes the current monster table
+    unsigned m_version; // The Dungeon's monster version the set was built for
+    long long m_travel; // How far the Player has travelled since the set was built
+    int m_lastRow; // The Player's row at the last update
+    int m_lastCol; // The Player's column at the last update
+    std::vector<int> m_near; // The monsters to check this turn
+    std::vector<int> m_dragons; // The Dragons, which are visited every turn
+    std::vector<int> m_visits; // The monsters to visit this turn, in table order
+    std::vector<unsigned char> m_inReach; // Whether each monster is within reach, by row
+    std::priority_queue<Dormant, std::vector<Dormant>, std::greater<Dormant>> m_dormant;
+};
+
+#endif // ACTIVITYSET_INCLUDED
\ No newline at end of file
@@ -2,11 +2,25 @@
 
 #include "Actor.h"
 #include "Dungeon.h"
+#include "Instrument.h"
 #include "Item.h"
-#include "utilities.h"
 #include <algorithm>
-#include <iostream>
-#include <queue>
+
+// The traits of each Actor kind, in the order of the ActorKind enum
+static const ActorTraits ACTORTRAITS[] =
+{
+    { "Player", '@', 0, 0, "", 0 },
+    { "Goblin", 'G', 0, 2, " slashes short sword at the ", 0 }, // N.B. Goblins smell instead
+    { "Bogeyman", 'B', 0, 2, " slashes short sword at the ", 5 },
+    { "Snakewoman", 'S', 3, 2, " strikes magic fangs at ", 3 },
+    { "Dragon", 'D', 2, 4, " swings long sword at the ", 1 }
+};
+
+// Accessor: returns the traits of the given Actor kind
+const ActorTraits& getActorTraits(ActorKind kind)
+{
+    return(ACTORTRAITS[static_cast<int>(kind)]);
+}
 
 /////////////////////////////////////
 // Actor Class Implementation
@@ -30,6 +44,7 @@ Actor::Actor(Dungeon* d, int sr, int sc)
     m_isWinner = false;
     m_isDead = false;
     m_dungeon = d;
+    m_statSlot = -1; // The statistics live in the Actor until it joins the monster table
 }
 
 // Actor destructor
@@ -41,49 +56,49 @@ Actor::~Actor()
 // Accessor: returns the Actor's row
 int Actor::row() const
 {
-    return(m_arow);
+    return(stat(&MonsterStats::row, m_arow));
 }
 
 // Accessor: returns the Actor's column
 int Actor::col() const
 {
-    return(m_acol);
+    return(stat(&MonsterStats::col, m_acol));
 }
 
 // Accessor: returns the Actor's armor points
 int Actor::getArmor() const
 {
-    return(m_armorPoints);
+    return(stat(&MonsterStats::armor, m_armorPoints));
 }
 
 // Accessor: returns the Actor's dexterity points
 int Actor::getDexterity() const
 {
-    return(m_dexterityPoints);
+    return(stat(&MonsterStats::dexterity, m_dexterityPoints));
 }
 
 // Accessor: returns the Actor's hit points
 int Actor::getHP() const
 {
-    return(m_hitPoints);
+    return(stat(&MonsterStats::hp, m_hitPoints));
 }
 
 // Accessor: returns the Actor's maximum hit points
 int Actor::getMaxHP() const
 {
-    return(m_maxHP);
+    return(stat(&MonsterStats::maxHP, m_maxHP));
 }
 
 // Accessor: returns the Actor's sleep time
 int Actor::getSleep() const
 {
-    return(m_sleepTime);
+    return(stat(&MonsterStats::sleep, m_sleepTime));
 }
 
 // Accessor: returns the Actor's strength points
 int Actor::getStrength() const
 {
-    return(m_strengthPoints);
+    return(stat(&MonsterStats::strength, m_strengthPoints));
 }
 
 // Accessor: returns the Actor's weapon index
@@ -110,89 +125,123 @@ Dungeon* Actor::getActorDungeon() const
     return(m_dungeon);
 }
 
-// Accessor: returns the Actor's type
+// Accessor: returns the Actor's kind
+ActorKind Actor::getActorKind() const
+{
+    return(m_actorKind);
+}
+
+// Accessor: returns the Actor's kind, as a name
 std::string Actor::getActorName() const
 {
-    return(m_actorType);
+    return(getActorTraits(m_actorKind).name);
+}
+
+// Accessor: returns how far away (in Manhattan distance) the Actor notices the Player
+int Actor::getReach() const
+{
+    return(getActorTraits(m_actorKind).reach);
 }
 
 // Accessor: displays the Actor's inventory
-void Actor::dispInventory() const
+void Actor::dispInventory(std::string&) const
 {
     return; // N.B. Only the Player may display an inventory
 }
 
+// Accessor: returns the number of Items the Actor carries
+int Actor::getInventorySize() const
+{
+    return(0); // N.B. Only the Player carries an inventory
+}
+
+// Accessor: returns the Item the Actor carries at the index
+const Item* Actor::getInventoryItem(int) const
+{
+    return(nullptr); // N.B. Only the Player carries an inventory
+}
+
 // Mutator: changes the Actor's coordinates
 void Actor::changeCoordinates(int deltaRow, int deltaCol)
 {
     // N.B. By design, this function worries only about the coordinates themselves
     // For status checking, this responsibility is left to the higher code
-    m_arow += deltaRow;
-    m_acol += deltaCol;
+    int& actorRow = stat(&MonsterStats::row, m_arow);
+    int& actorCol = stat(&MonsterStats::col, m_acol);
+    actorRow += deltaRow;
+    actorCol += deltaCol;
+
+    // Keep the Dungeon's occupancy index in step with the new coordinates
+    m_dungeon->actorMoved(this, actorRow - deltaRow, actorCol - deltaCol, actorRow, actorCol);
 }
 
 // Mutator: changes the Actor's statistics
-void Actor::changeStats(int modifier, std::string category)
+void Actor::changeStats(int modifier, StatCategory category)
 {
     // Change the appropriate category's statistic
-    if (category == "Max HP")
+    if (category == StatCategory::MaxHP)
     {
-        m_maxHP += modifier;
+        int& maxHP = stat(&MonsterStats::maxHP, m_maxHP);
+        maxHP += modifier;
 
         // The maximum hit points level is 99
-        if (m_maxHP > 99)
+        if (maxHP > 99)
         {
-            m_maxHP = 99;
+            maxHP = 99;
         }
     }
-    else if (category == "HP")
+    else if (category == StatCategory::HP)
     {
-        m_hitPoints += modifier;
+        int& hitPoints = stat(&MonsterStats::hp, m_hitPoints);
+        hitPoints += modifier;
 
         // The hit points level cannot exceed 99 nor the maximum hit points level
-        if (m_hitPoints > 99)
+        if (hitPoints > 99)
         {
-            m_hitPoints = 99;
+            hitPoints = 99;
         }
-        else if (m_hitPoints > m_maxHP)
+        else if (hitPoints > getMaxHP())
         {
-            m_hitPoints = m_maxHP;
+            hitPoints = getMaxHP();
         }
     }
-    else if (category == "Armor")
+    else if (category == StatCategory::Armor)
     {
-        m_armorPoints += modifier;
+        int& armorPoints = stat(&MonsterStats::armor, m_armorPoints);
+        armorPoints += modifier;
 
         // The armor points level cannot exceed 99
-        if (m_armorPoints > 99)
+        if (armorPoints > 99)
         {
-            m_armorPoints = 99;
+            armorPoints = 99;
         }
     }
-    else if (category == "Strength")
+    else if (category == StatCategory::Strength)
     {
-        m_strengthPoints += modifier;
+        int& strengthPoints = stat(&MonsterStats::strength, m_strengthPoints);
+        strengthPoints += modifier;
 
         // The strength points level cannot exceed 99
-        if (m_strengthPoints > 99)
+        if (strengthPoints > 99)
         {
-            m_strengthPoints = 99;
+            strengthPoints = 99;
         }
     }
-    else if (category == "Dexterity")
+    else if (category == StatCategory::Dexterity)
     {
-        m_dexterityPoints += modifier;
+        int& dexterityPoints = stat(&MonsterStats::dexterity, m_dexterityPoints);
+        dexterityPoints += modifier;
 
         // The dexterity points level cannot exceed 99
-        if (m_dexterityPoints > 99)
+        if (dexterityPoints > 99)
         {
-            m_dexterityPoints = 99;
+            dexterityPoints = 99;
         }
     }
-    else if (category == "Sleep")
+    else if (category == StatCategory::Sleep)
     {
         // This section is only used to decrement the existing sleep time.
-        m_sleepTime += modifier;
+        stat(&MonsterStats::sleep, m_sleepTime) += modifier;
     }
 }
 
@@ -203,10 +252,10 @@ bool Actor::pickUp(int, int, bool)
 }
 
 // Mutator: Actor drops appropriate spoils of war
-void Actor::monsterDrop(std::string name)
+void Actor::monsterDrop(ActorKind kind)
 {
     // N.B. By design, assume that the higher code calls appropriately
-    if (m_actorType == "Player")
+    if (m_actorKind == ActorKind::Player)
     {
         return; // While this should never trigger, it safeguards against a bad call.
     }
@@ -214,10 +263,10 @@ void Actor::monsterDrop(std::string name)
     bool dropChance; // Indicates whether a Monster drop occurs
 
     // N.B. By design, this function will not be called unless the tile will be empty
-    if (name == "Goblin")
+    if (kind == ActorKind::Goblin)
     {
         // Goblins have a 1/3 chance of dropping an item
-        dropChance = trueWithProbability(1.0 / 3.0); 
+        dropChance = m_dungeon->rng().trueWithProbability(1.0 / 3.0); 
 
         if (!dropChance)
         {
@@ -226,7 +275,7 @@ void Actor::monsterDrop(std::string name)
         else
         {
             // Contains the probability that the Goblin drops a magic axe and not magic fangs
-            bool isAxe = trueWithProbability(1.0 / 2.0);
+            bool isAxe = m_dungeon->rng().trueWithProbability(1.0 / 2.0);
             std::string dropType = "";
 
             if (isAxe)
@@ -238,13 +287,13 @@ void Actor::monsterDrop(std::string name)
                 dropType = "magic fangs";
             }
 
-            m_dungeon->addDrop(m_arow, m_acol, dropType, "Weapon");
+            m_dungeon->addDrop(row(), col(), dropType, "Weapon");
         }
     }
-    else if (name == "Snakewoman")
+    else if (kind == ActorKind::Snakewoman)
     {
         // Snakewomen have a 1/3 chance of dropping their magic fangs
-        dropChance = trueWithProbability(1.0 / 3.0);
+        dropChance = m_dungeon->rng().trueWithProbability(1.0 / 3.0);
 
         if (!dropChance)
         {
@@ -253,22 +302,22 @@ void Actor::monsterDrop(std::string name)
         else
         {
             std::string dropType = "magic fangs";
-            m_dungeon->addDrop(m_arow, m_acol, dropType, "Weapon");
+            m_dungeon->addDrop(row(), col(), dropType, "Weapon");
         }
     }
-    else if (name == "Dragon")
+    else if (kind == ActorKind::Dragon)
     {
         dropChance = true; // Dragons are guaranteed to drop a Scroll of some kind
         std::string scrollTypes[5] = { "improve armor", "strength", "enhance health", 
             "enhance dexterity", "teleportation" };
-        int index = randInt(0, 4); // Chooses a random Scroll to drop
+        int index = m_dungeon->rng().randInt(0, 4); // Chooses a random Scroll to drop
 
-        m_dungeon->addDrop(m_arow, m_acol, scrollTypes[index], "Scroll");
+        m_dungeon->addDrop(row(), col(), scrollTypes[index], "Scroll");
     }
-    else if (name == "Bogeyman")
+    else if (kind == ActorKind::Bogeyman)
     {
         // Bogeymen have a 1/10 chance of dropping an item
-        dropChance = trueWithProbability(1.0 / 10.0);
+        dropChance = m_dungeon->rng().trueWithProbability(1.0 / 10.0);
 
         if (!dropChance)
         {
@@ -277,7 +326,7 @@ void Actor::monsterDrop(std::string name)
         else
         {
             std::string dropType = "magic axe";
-            m_dungeon->addDrop(m_arow, m_acol, dropType, "Weapon");
+            m_dungeon->addDrop(row(), col(), dropType, "Weapon");
         }
     }
 }
@@ -285,6 +334,8 @@ void Actor::monsterDrop(std::string name)
 // Mutator: the Actor attacks (i.e. the Monster attacks the Player)
 bool Actor::attack(int r, int c)
 {
+    INSTRUMENT_PHASE(InstrumentPhase::Attack);
+
     // N.B. By design, assume that the higher code calls appropriately
     
     // Retrieve the Player's coordinates
@@ -297,79 +348,59 @@ bool Actor::attack(int r, int c)
     }
 
     // Gather the attack parameters according to the Monster
-    int weaponDexterity = 0;
-    int weaponDamage = 0;
-    std::string result = m_actorType;
-
-    if (m_actorType == "Goblin" || m_actorType == "Bogeyman")
-    {
-        weaponDamage = 2;
-        result += " slashes short sword at the ";
-    }
-    else if (m_actorType == "Dragon")
-    {
-        weaponDexterity = 2;
-        weaponDamage = 4;
-        result += " swings long sword at the ";
-    }
-    else // m_actorType == "Snakewoman"
-    {
-        weaponDexterity = 3;
-        weaponDamage = 2;
-        result += " strikes magic fangs at ";
-    }
-
-    result += "Player";
+    const ActorTraits& traits = getActorTraits(m_actorKind);
+    int weaponDexterity = traits.weaponDexterity;
+    int weaponDamage = traits.weaponDamage;
+    MessageLog& messages = m_dungeon->messages();
 
     // Determine whether the Actor hits or misses
-    int attackerPoints = m_dexterityPoints + weaponDexterity;
+    int attackerPoints = getDexterity() + weaponDexterity;
     int defenderPoints = m_dungeon->player()->getDexterity() + m_dungeon->player()->getArmor();
 
-    if (randInt(1, attackerPoints) < randInt(1, defenderPoints))
+    // N.B. The rolls are drawn in turn, as operands of one comparison may be evaluated in
+    // either order, which would make the same seed play out differently between compilers
+    int attackRoll = m_dungeon->rng().randInt(1, attackerPoints);
+    int defenseRoll = m_dungeon->rng().randInt(1, defenderPoints);
+
+    if (attackRoll < defenseRoll)
     {
-        // Newline character is used in case multiple Monsters are attacking
-        result += " and misses. \n"; 
-        m_dungeon->setMonsterAttackString(result);
+        messages.post(MessageId::MonsterMisses, m_actorKind, ItemKind::None, 0);
         return(false);  // The Actor missed, thus return immediately
     }
     else
     {
         // The Actor hits, thus determine the damage dealt
-        int damagePoints = randInt(0, m_strengthPoints + weaponDamage - 1);
-        m_dungeon->player()->changeStats(-damagePoints, "HP"); // Decrement Player's hit points
+        int damagePoints = m_dungeon->rng().randInt(0, getStrength() + weaponDamage - 1);
+        m_dungeon->player()->changeStats(-damagePoints, StatCategory::HP); // Decrement Player's hit points
 
         // If the Player is dead, output the appropriate string
         if (m_dungeon->player()->getHP() <= 0)
         {
-            result += ", dealing a final blow. \n";
             m_dungeon->player()->setDead(); // Sets Player to be dead
-            m_dungeon->setMonsterAttackString(result);
+            messages.post(MessageId::MonsterKills, m_actorKind, ItemKind::None, damagePoints);
             return(true); // The Actor hit and the Player is dead, thus return immediately
         }
 
         // If the Actor is a Snakewoman, check whether it puts the Player to sleep
-        if (m_actorType == "Snakewoman")
+        if (m_actorKind == ActorKind::Snakewoman)
         {
             // Magic Fangs of Sleep have a 1/5 chance of putting the defender to sleep
-            bool setSleep = trueWithProbability(1.0 / 5.0);
+            bool setSleep = m_dungeon->rng().trueWithProbability(1.0 / 5.0);
 
             if (setSleep)
             {
-                result += " and hits, putting the Player to sleep.";
-                m_dungeon->player()->setSleep(randInt(2, 6));
+                m_dungeon->player()->setSleep(m_dungeon->rng().randInt(2, 6));
+                messages.post(MessageId::MonsterPutsToSleep, m_actorKind, ItemKind::None, damagePoints);
             }
             else
             {
-                result += " and hits. \n";
+                messages.post(MessageId::MonsterHits, m_actorKind, ItemKind::None, damagePoints);
             }
 
-            // Set the appropriate output string, and return immediately
-            m_dungeon->setMonsterAttackString(result);
-            return(true);
+            return(true); // Return immediately
         }
 
-        result += " and hits. \n";
-        m_dungeon->setMonsterAttackString(result);
+        messages.post(MessageId::MonsterHits, m_actorKind, ItemKind::None, damagePoints);
         return(true);
     }
 }
@@ -377,56 +408,92 @@ bool Actor::attack(int r, int c)
 // Mutator: sets the Actor's armor points
 void Actor::setArmor(int armor)
 {
-    m_armorPoints = armor;
+    stat(&MonsterStats::armor, m_armorPoints) = armor;
 }
 
 // Mutator: sets the Actor's dexterity points
 void Actor::setDexterity(int dexterity)
 {
-    m_dexterityPoints = dexterity;
+    stat(&MonsterStats::dexterity, m_dexterityPoints) = dexterity;
 }
 
 // Mutator: sets the Actor's hit points
 void Actor::setHP(int hp)
 {
-    m_hitPoints = hp;
+    stat(&MonsterStats::hp, m_hitPoints) = hp;
 }
 
 // Mutator: sets the Actor's maximum hit points
 void Actor::setMaxHP(int maxHP)
 {
-    m_maxHP = maxHP;
+    stat(&MonsterStats::maxHP, m_maxHP) = maxHP;
 }
 
 // Mutator: sets the Actor's sleep time
 void Actor::setSleep(int time)
 {
-    m_sleepTime = std::max(m_sleepTime, time);
+    int& sleepTime = stat(&MonsterStats::sleep, m_sleepTime);
+    sleepTime = std::max(sleepTime, time);
 }
 
 // Mutator: sets the Actor's strength points
 void Actor::setStrength(int strength)
 {
-    m_strengthPoints = strength;
+    stat(&MonsterStats::strength, m_strengthPoints) = strength;
 }
 
-// Mutator: sets the Actor's type
-void Actor::setActorType(std::string name)
+// Mutator: sets the Actor's kind
+void Actor::setActorKind(ActorKind kind)
 {
-    m_actorType = name;
+    m_actorKind = kind;
+}
+
+// Mutator: moves the Actor to another Dungeon (e.g. one that took over its level)
+void Actor::setActorDungeon(Dungeon* d)
+{
+    m_dungeon = d;
+}
+
+// Mutator: moves the Actor's statistics to the given row of the Dungeon's monster table
+void Actor::setStatSlot(int slot)
+{
+    // N.B. By design, the Dungeon has already copied the statistics into that row
+    m_statSlot = slot;
+}
+
+// Private Helper Function: returns a statistic, from the monster table if the Actor is in it
+int Actor::stat(std::vector<int> MonsterStats::* field, int own) const
+{
+    if (m_statSlot == -1)
+    {
+        return(own);
+    }
+
+    return((m_dungeon->monsterStats().*field)[m_statSlot]);
+}
+
+// Private Helper Function: returns a statistic to modify, wherever the Actor keeps it
+int& Actor::stat(std::vector<int> MonsterStats::* field, int& own)
+{
+    if (m_statSlot == -1)
+    {
+        return(own);
+    }
+
+    return((m_dungeon->monsterStats().*field)[m_statSlot]);
 }
 
 // Mutator: sets the Actor to be dead
 void Actor::setDead()
 {
-    if (m_actorType == "Player")
+    if (m_actorKind == ActorKind::Player)
     {
         m_isDead = true;
         return;
     }
     
     // Retrieve the index of the Monster that is killed
-    int correctIndex = m_dungeon->actorAtPos(m_arow, m_acol);
+    int correctIndex = m_dungeon->actorAtPos(row(), col());
     int r = m_dungeon->getMonsters()[correctIndex]->row();
     int c = m_dungeon->getMonsters()[correctIndex]->col();
 
@@ -434,8 +501,8 @@ void Actor::setDead()
     if (m_dungeon->getStatus(r, c) == ACTOR)
     {
         m_dungeon->setStatus(r, c, EMPTY);
-        std::string monsterName = m_dungeon->getMonsters()[correctIndex]->getActorName();
-        monsterDrop(monsterName); // Sets the monster drop accordingly, if there is one
+        ActorKind monsterKind = m_dungeon->getMonsters()[correctIndex]->getActorKind();
+        monsterDrop(monsterKind); // Sets the monster drop accordingly, if there is one
     }
     else // m_dungeon->getStatus(r, c) == ACTORITEM
     {
@@ -465,7 +532,7 @@ Player::Player(Dungeon* d, int sr, int sc)
     setHP(20); 
     setMaxHP(20); 
     setStrength(2);
-    setActorType("Player");
+    setActorKind(ActorKind::Player);
     
     // Initially, the Player begins with a short sword
     Item* playerWeapon = new Weapon(getActorDungeon(), this, "short sword", -1, -1);
@@ -483,17 +550,16 @@ Player::~Player()
     }
 }
 
-// Accessor: displays the Player's inventory
-void Player::dispInventory() const
+// Accessor: draws the Player's inventory into the frame buffer
+void Player::dispInventory(std::string& frame) const
 {
-    // As the function is constant, iterate through playerInventory variable instead
-    std::vector<Item*> playerInventory = m_inventory;
-    std::vector<Item*>::iterator it = playerInventory.begin();
+    // As the function is constant, iterate through the inventory with a const iterator
+    std::vector<Item*>::const_iterator it;
     char front = 'a'; // Set our display prefix character
-    std::cout << "Inventory: " << std::endl;
+    frame += "Inventory: \n";
 
     // Loop through the inventory and print out the items
-    for (it = playerInventory.begin(); it < playerInventory.end(); it++)
+    for (it = m_inventory.begin(); it < m_inventory.end(); it++)
     {
         std::string itemname = (*it)->getName(); // Retrieve the Item's name
 
@@ -505,7 +571,8 @@ void Player::dispInventory() const
             itemname = "A scroll called scroll of " + itemname;
         }
 
-        std::cout << front << ". " << itemname << std::endl;
+        frame += front;
+        frame += ". " + itemname + '\n';
         front++; // Increment our display prefix character
     }
 }
@@ -516,11 +583,38 @@ int Player::getWeaponIndex() const
     return(m_playerWeapon);
 }
 
+// Accessor: returns the number of Items in the Player's inventory
+int Player::getInventorySize() const
+{
+    return(m_inventory.size());
+}
+
+// Accessor: returns the Item at the index of the Player's inventory
+const Item* Player::getInventoryItem(int index) const
+{
+    // N.B. By design, assume that the higher code asks for an Item that exists
+    return(m_inventory[index]);
+}
+
+// Mutator: replaces the Player's inventory (e.g. when loading a Game), taking the Items over
+void Player::setInventory(const std::vector<Item*>& items, int weapon)
+{
+    for (size_t i = 0; i < m_inventory.size(); i++)
+    {
+        delete m_inventory[i];
+    }
+
+    m_inventory = items;
+    m_playerWeapon = weapon;
+}
+
 // Mutator: the Player attacks [the Monster]
 bool Player::attack(int r, int c)
 {
+    INSTRUMENT_PHASE(InstrumentPhase::Attack);
+
     // Retrieve the Monster at the intended coordinates
-    std::vector<Actor*> targetMonster = getActorDungeon()->getMonsters();
+    const std::vector<Actor*>& targetMonster = getActorDungeon()->getMonsters();
     int index = getActorDungeon()->actorAtPos(r, c);
 
     // N.B. Assume the higher code is calling this function appropriately
@@ -532,84 +626,58 @@ bool Player::attack(int r, int c)
 
     // Determine the attack parameters and Monster accordingly
     Actor* playerTarget = targetMonster[index];
-    std::string monsterName = playerTarget->getActorName();
+    ActorKind monsterKind = playerTarget->getActorKind();
     int attackerPoints = getDexterity() + m_inventory[m_playerWeapon]->getWeaponDexterity();
     int defenderPoints = playerTarget->getDexterity() + playerTarget->getArmor();
 
-    // Retrieve the Player's currently wielded Weapon
-    std::string weaponName = m_inventory[m_playerWeapon]->getName();
-    std::string result = "Player ";
-
-    // Adjust the result according to the currently wielded Weapon
-    if (weaponName == "mace")
-    {
-        result += "swings mace at the ";
-    }
-    else if (weaponName == "short sword")
-    {
-        result += "slashes short sword at the ";
-    }
-    else if (weaponName == "long sword")
-    {
-        result += "swings long sword at the ";
-    }
-    else if (weaponName == "magic axe")
-    {
-        result += "chops magic axe at ";
-    }
-    else // weaponName == "magic fangs"
-    {
-        result += "strikes magic fangs at ";
-    }
-
-    result += monsterName;
+    // Retrieve the Player's currently wielded Weapon, which the Messages name
+    ItemKind weaponKind = m_inventory[m_playerWeapon]->getItemKind();
+    MessageLog& messages = getActorDungeon()->messages();
 
     // Determine whether the Player hits or misses
-    if (randInt(1, attackerPoints) < randInt(1, defenderPoints))
+    int attackRoll = getActorDungeon()->rng().randInt(1, attackerPoints); // N.B. Drawn in turn
+    int defenseRoll = getActorDungeon()->rng().randInt(1, defenderPoints);
+
+    if (attackRoll < defenseRoll)
     {
-        result += " and misses.";
-        getActorDungeon()->setPlayerAttackString(result);
+        messages.post(MessageId::PlayerMisses, monsterKind, weaponKind, 0);
         return(false); // The Player missed, thus return immediately
     }
     else
     {
         // The Player hits, thus determine the damage dealth
-        int damagePoints = randInt(0, getStrength() + 
+        int damagePoints = getActorDungeon()->rng().randInt(0, getStrength() + 
             m_inventory[m_playerWeapon]->getWeaponDamage() - 1);
-        playerTarget->changeStats(-damagePoints, "HP"); // Decrement Monster's hit points
+        playerTarget->changeStats(-damagePoints, StatCategory::HP); // Decrement Monster's hit points
         
         // If the Monster is dead, output the appropriate string
         if (playerTarget->getHP() <= 0)
         {
-            result += ", dealing a final blow.";
             playerTarget->setDead(); // Sets Monster to be dead
-            getActorDungeon()->setPlayerAttackString(result);
+            messages.post(MessageId::PlayerKills, monsterKind, weaponKind, damagePoints);
             return(true); // The Player hit and the Monster is dead, thus return immediately
         }
 
         // If the wielded Weapon is a magic fangs, check if it puts the Monster to sleep
-        if (weaponName == "magic fangs")
+        if (weaponKind == ItemKind::MagicFangs)
         {
             // Magic Fangs of Sleep have a 1/5 chance of putting the defender to sleep
-            bool isAsleep = trueWithProbability(1.0 / 5.0);
+            bool isAsleep = getActorDungeon()->rng().trueWithProbability(1.0 / 5.0);
 
             if (isAsleep)
             {
-                result += " and hits, putting the " + monsterName + " to sleep.";
-                playerTarget->setSleep(randInt(2, 6));
+                playerTarget->setSleep(getActorDungeon()->rng().randInt(2, 6));
+                messages.post(MessageId::PlayerPutsToSleep, monsterKind, weaponKind, damagePoints);
             }
             else
             {
-                result += " and hits.";
+                messages.post(MessageId::PlayerHits, monsterKind, weaponKind, damagePoints);
             }
 
-            // Output the appropriate result string
-            getActorDungeon()->setPlayerAttackString(result);
             return(true);
         }
 
-        result += " and hits.";
-        getActorDungeon()->setPlayerAttackString(result);
+        messages.post(MessageId::PlayerHits, monsterKind, weaponKind, damagePoints);
         return(true);
     }
 }
@@ -654,47 +722,39 @@ bool Player::pickUp(int r, int c, bool gflag)
 
     if (getActorDungeon()->getStatus(r, c) == ACTORITEM && gflag && (inventorySize <= 25))
     {
-        std::string result = "You pick up ";
         int correctIndex = getActorDungeon()->itemAtPos(r, c); // Retrieve the Idem's index
 
-        // Obtain the Item's parameters (i.e. name, type, etc.)
+        // Obtain the Item's parameters (i.e. kind, type, etc.)
         Item* myItem = getActorDungeon()->getAvailItems()[correctIndex];
-        std::string itemName = myItem->getName();
-        std::string itemClass = myItem->getType();
+        ItemKind itemKind = myItem->getItemKind();
+        MessageLog& messages = getActorDungeon()->messages();
 
-        if (myItem->getName() == "Stairway")
+        if (itemKind == ItemKind::Stairway)
         {
             return(false); // Do nothing, because you must press '>'
         }
-        else if (myItem->getName() == "Golden Idol")
+        else if (itemKind == ItemKind::GoldenIdol)
         {
-            result += "the golden idol.";
-            getActorDungeon()->setPlayerPickUpString(result);
+            messages.post(MessageId::PickUpIdol, ActorKind::Player, itemKind, 0);
             setWinner(); // Set the Player as the winner
             return(true);
         }
 
-        // Modify the output string depending on the Item type
-        if (itemClass == "Weapon")
+        // Post the Message depending on the Item type
+        if (myItem->getType() == "Weapon")
         {
-            // Adjust the name for magic fangs of sleep
-            if (itemName == "magic fangs")
-            {
-                itemName = "magic fangs of sleep";
-            }
-            
-            result += "a " + itemName + ".";
+            messages.post(MessageId::PickUpWeapon, ActorKind::Player, itemKind, 0);
         }
         else
         {
-            result += "a scroll called scroll of " + itemName + ".";
+            messages.post(MessageId::PickUpScroll, ActorKind::Player, itemKind, 0);
         }
 
-        getActorDungeon()->setPlayerPickUpString(result);
-
         // Transfer the Item from the Dungeon to the Player
-        myItem->setOwner(this);
-        m_inventory.push_back(myItem);
+        // N.B. The floor Item belongs to the level's Arena, so the Player keeps a copy of it
+        Item* ownedItem = myItem->clone();
+        ownedItem->setOwner(this);
+        m_inventory.push_back(ownedItem);
         getActorDungeon()->removeItem(correctIndex);
         getActorDungeon()->setStatus(r, c, ACTOR);
 
@@ -706,7 +766,7 @@ bool Player::pickUp(int r, int c, bool gflag)
         int correctIndex = getActorDungeon()->itemAtPos(r, c);
         Item* myItem = getActorDungeon()->getAvailItems()[correctIndex];
 
-        if (myItem->getName() == "Stairway")
+        if (myItem->getItemKind() == ItemKind::Stairway)
         {
             // Generate a new level
             int currlevel = getActorDungeon()->getLevel();
@@ -726,21 +786,18 @@ bool Player::pickUp(int r, int c, bool gflag)
             return(false); // While this should never trigger, it safeguards against bad calls
         }
 
-        std::string name = getActorDungeon()->getAvailItems()[correctIndex]->getName();
+        ItemKind itemKind = getActorDungeon()->getAvailItems()[correctIndex]->getItemKind();
+        MessageLog& messages = getActorDungeon()->messages();
 
         // Player can pick up the golden idol, even with a full inventory
-        std::string result = "";
-
-        if (name == "Golden Idol")
+        if (itemKind == ItemKind::GoldenIdol)
         {
-            result = "You pick up the golden idol.";
-            getActorDungeon()->setPlayerPickUpString(result);
+            messages.post(MessageId::PickUpIdol, ActorKind::Player, itemKind, 0);
             setWinner(); // Set Player as winner
             return(true);
         }
 
-        result = "Your knapsack is full; you can't pick that up.";
-        getActorDungeon()->setPlayerPickUpString(result);
+        messages.post(MessageId::KnapsackFull, ActorKind::Player, itemKind, 0);
         return(false);
     }
 }
@@ -765,33 +822,9 @@ bool Player::readScroll(char c)
         {
             m_inventory[sizeChar]->wieldItem(); // Player reads the selected Scroll
 
-            std::string result = "You read the scroll called scroll of ";
-            std::string scrollName = m_inventory[sizeChar]->getName();
-            result += scrollName;
-
-            // Set the output string depending on the Scroll type
-            if (scrollName == "teleportation")
-            {
-                result += ". \nYou feel your body wrenched in space and time.";
-            }
-            else if (scrollName == "strength")
-            {
-                result += ". \nYour muscles bulge.";
-            }
-            else if (scrollName == "improve armor")
-            {
-                result += ". \nYour armor glows blue.";
-            }
-            else if (scrollName == "enhance health")
-            {
-                result += ". \nYou feel your heart beating stronger.";
-            }
-            else // scrollName == "enhance dexterity"
-            {
-                result += ". \nYou feel like less of a klutz.";
-            }
-
-            getActorDungeon()->setPlayerScrollString(result); // Set the output string
+            // Post the Message, which names the Scroll and describes its effect
+            getActorDungeon()->messages().post(MessageId::ReadScroll, ActorKind::Player,
+                m_inventory[sizeChar]->getItemKind(), 0);
 
             // Delete the Scroll, as it is expended upon usage
             std::vector<Item*>::iterator it = m_inventory.begin() + sizeChar;
@@ -801,16 +834,9 @@ bool Player::readScroll(char c)
         }
         else
         {
-            std::string itemName = m_inventory[sizeChar]->getName();
-
-            if (itemName == "magic fangs")
-            {
-                itemName = "magic fangs of sleep";
-            }
-
             // Player cannot read a Weapon
-            std::string result = "You can't read a " + itemName + ".";
-            getActorDungeon()->setPlayerScrollString(result);
+            getActorDungeon()->messages().post(MessageId::CannotRead, ActorKind::Player,
+                m_inventory[sizeChar]->getItemKind(), 0);
         }
         return(false);
     }
@@ -834,17 +860,9 @@ bool Player::wieldWeapon(char c)
     {
         if (m_inventory[sizeChar]->getType() == "Weapon")
         {
-            // Set the output string depending on the chosen Weapon
-            std::string result = "You are wielding a ";
-            std::string weaponName = m_inventory[sizeChar]->getName();
-
-            if (weaponName == "magic fangs")
-            {
-                weaponName = "magic fangs of sleep";
-            }
-
-            result += weaponName + ".";
-            getActorDungeon()->setPlayerWieldString(result);
+            // Post the Message naming the chosen Weapon
+            getActorDungeon()->messages().post(MessageId::WieldWeapon, ActorKind::Player,
+                m_inventory[sizeChar]->getItemKind(), 0);
 
             m_playerWeapon = sizeChar; // Change Player's index of the wielded Weapon
             return(true);
@@ -852,9 +870,8 @@ bool Player::wieldWeapon(char c)
         else
         {
             // Player cannot wield a Scroll
-            std::string scrollName = m_inventory[sizeChar]->getName();
-            std::string result = "You can't wield a scroll of " + scrollName + ".";
-            getActorDungeon()->setPlayerWieldString(result);
+            getActorDungeon()->messages().post(MessageId::CannotWield, ActorKind::Player,
+                m_inventory[sizeChar]->getItemKind(), 0);
         }
         return(false);
     }
@@ -869,23 +886,43 @@ Goblin::Goblin(Dungeon* d, int sr, int sc, int smellDistance)
     : Actor(d, sr, sc)
 {
     // Set Goblin's statistics accordingly
-    int hp = randInt(15, 20); // Goblin begins with random hit points from 15-20
+    int hp = getActorDungeon()->rng().randInt(15, 20); // Goblin begins with random hit points from 15-20
     setArmor(1);
     setDexterity(1);
     setHP(hp);
     setMaxHP(hp);
     setStrength(3);
-    setActorType("Goblin");
+    setActorKind(ActorKind::Goblin);
     
     // All Goblins carry the short sword
-    m_goblinWeapon = new Weapon(getActorDungeon(), this, "short sword", -1, -1);
+    m_goblinWeapon = getActorDungeon()->arena().create<Weapon>(getActorDungeon(), this,
+        "short sword", -1, -1);
     m_goblinSmellDistance = smellDistance; // Set the Goblin's smell distance
+    m_goblinRoutePlayer = -1; // The Goblin has no route yet
+    m_goblinRouteChanges = 0;
 }
 
 // Goblin destructor
 Goblin::~Goblin()
 {
-    delete m_goblinWeapon; // Delete the Goblin's Weapon
+    // N.B. The Goblin's Weapon lives in the Dungeon's Arena, which destroys it
+}
+
+// Accessor: returns the Goblin's smell distance, as far away as it notices the Player
+int Goblin::getReach() const
+{
+    return(m_goblinSmellDistance);
+}
+
+// Mutator: moves the Goblin, and the Weapon it carries, to another Dungeon
+void Goblin::setActorDungeon(Dungeon* d)
+{
+    Actor::setActorDungeon(d);
+    m_goblinWeapon->setItemDungeon(d);
+
+    // A route worked out in the old Dungeon means nothing in the new one
+    m_goblinRoute.clear();
+    m_goblinRoutePlayer = -1;
 }
 
 // Mutator: Goblin reads Scroll (does nothing)
@@ -927,305 +964,250 @@ bool Goblin::move(int drow, int dcol)
         int deltaRow = 0; // Distance to move vertically
         int deltaCol = 0; // Distance to move horizontally
 
-        bool N, S, E, W; // Booleans indicate whether directional tiles are traversable 
-        N = true; S = true; E = true; W = true; // Initially, assume all paths are available
-
-        // Indicates distance in each directiion
-        int northSteps = 1000;
-        int southSteps = 1000; 
-        int eastSteps = 1000; 
-        int westSteps = 1000;
-
-        // Retrieve directional cells' status
-        if (getActorDungeon()->getStatus(drow - 1, dcol) != EMPTY &&
-            getActorDungeon()->getStatus(drow - 1, dcol) != ITEM)
+        // Keep to the route worked out earlier if nothing since could change it
+        if (!followRoute(prow, pcol, deltaRow, deltaCol))
         {
-            N = false;
-            northSteps = m_goblinSmellDistance + 1; // If not traversable, set invalid distance
-        }
-        if (getActorDungeon()->getStatus(drow + 1, dcol) != EMPTY &&
-            getActorDungeon()->getStatus(drow + 1, dcol) != ITEM)
-        {
-            S = false;
-            southSteps = m_goblinSmellDistance + 1; // If not traversable, set invalid distance
+            if (!planRoute(prow, pcol))
+            {
+                return(false); // Player is either unreachable or not within smell distance
+            }
+
+            followRoute(prow, pcol, deltaRow, deltaCol);
         }
-        if (getActorDungeon()->getStatus(drow, dcol + 1) != EMPTY &&
-            getActorDungeon()->getStatus(drow, dcol + 1) != ITEM)
+
+        // Move the Goblin appropriately
+        if (getActorDungeon()->getStatus(row(), col()) == ACTOR)
         {
-            E = false;
-            eastSteps = m_goblinSmellDistance + 1; // If not traversable, set invalid distance
+            getActorDungeon()->setStatus(row(), col(), EMPTY);
         }
-        if (getActorDungeon()->getStatus(drow, dcol - 1) != EMPTY &&
-            getActorDungeon()->getStatus(drow, dcol - 1) != ITEM)
+        else // getActorDungeon()->getStatus(row(), col()) == ACTORITEM
         {
-            W = false;
-            westSteps = m_goblinSmellDistance + 1; // If not traversable, set invalid distance
+            getActorDungeon()->setStatus(row(), col(), ITEM);
         }
 
-        // Initialize a grid to test for grid distance
-        int maze[18][70];
+        changeCoordinates(deltaRow, deltaCol);
 
-        // Initialize our test maze
-        for (int r = 0; r < getActorDungeon()->getRow(); r++)
+        if (getActorDungeon()->getStatus(row(), col()) == EMPTY)
         {
-            for (int c = 0; c < getActorDungeon()->getCol(); c++)
-            {
-                if (getActorDungeon()->getStatus(r, c) != EMPTY && 
-                    getActorDungeon()->getStatus(r, c) != ITEM)
-                {
-                    maze[r][c] = 1000; // This indicates that the cell is not traversable
-                }
-                else
-                {
-                    maze[r][c] = 0;
-                }
-            }
-        }
-        maze[prow][pcol] = 0; // Don't forget to set the target cell as reachable
-        maze[drow][dcol] = 0; // For completeness, set the monster's current cell as reachable too
-        int tracker = 1; // Marks the level of each visited cell
-
-        if (pathExists(maze, drow, dcol, prow, pcol, tracker) && 
-            shortestPath(maze, prow, pcol, drow, dcol) <= m_goblinSmellDistance)
-        {
-            // Calculate North steps
-            if (N)
-            {
-                resetMaze(maze);
-                if (pathExists(maze, drow - 1, dcol, prow, pcol, tracker))
-                    northSteps = shortestPath(maze, prow, pcol, drow - 1, dcol);
-            }
-
-            // Calculate South steps
-            if (S)
-            {
-                resetMaze(maze);
-                if (pathExists(maze, drow + 1, dcol, prow, pcol, tracker))
-                    southSteps = shortestPath(maze, prow, pcol, drow + 1, dcol);
-            }
-
-            // Calculate East steps
-            if (E)
-            {
-                resetMaze(maze);
-                if (pathExists(maze, drow, dcol + 1, prow, pcol, tracker))
-                    eastSteps = shortestPath(maze, prow, pcol, drow, dcol + 1);
-            }
-
-            // Calculate West steps
-            if (W)
-            {
-                resetMaze(maze);
-                if (pathExists(maze, drow, dcol - 1, prow, pcol, tracker))
-                    westSteps = shortestPath(maze, prow, pcol, drow, dcol - 1);
-            }
-
-            // Choose direction with the minimum distance
-            if (N && northSteps <= southSteps && northSteps <= eastSteps && northSteps <= westSteps)
-            {
-                deltaRow = -1;
-            }
-            else if (S && southSteps <= northSteps && southSteps <= eastSteps && southSteps <= westSteps)
-            {
-                deltaRow = 1;
-            }
-            else if (W && westSteps <= northSteps && westSteps <= eastSteps && westSteps <= southSteps)
-            {
-                deltaCol = -1;
-            }
-            else if (E && eastSteps <= northSteps && eastSteps <= westSteps && eastSteps <= southSteps)
-            {
-                deltaCol = 1;
-            }
-            
-            // Move the Goblin appropriately
-            if (getActorDungeon()->getStatus(row(), col()) == ACTOR)
-            {
-                getActorDungeon()->setStatus(row(), col(), EMPTY);
-            }
-            else // getActorDungeon()->getStatus(row(), col()) == ACTORITEM
-            {
-                getActorDungeon()->setStatus(row(), col(), ITEM);
-            }
-            
-            changeCoordinates(deltaRow, deltaCol);
-
-            if (getActorDungeon()->getStatus(row(), col()) == EMPTY)
-            {
-                getActorDungeon()->setStatus(row(), col(), ACTOR);
-            }
-            else // getActorDungeon()->getStatus(row(), col()) == ITEM
-            {
-                getActorDungeon()->setStatus(row(), col(), ACTORITEM);
-            }
+            getActorDungeon()->setStatus(row(), col(), ACTOR);
         }
-        else
+        else // getActorDungeon()->getStatus(row(), col()) == ITEM
         {
-            return(false); // Player is either unreachable or not within smell distance
+            getActorDungeon()->setStatus(row(), col(), ACTORITEM);
         }
+
+        // The two cells the Goblin's own step switched cannot change the rest of its route
+        m_goblinRouteChanges = getActorDungeon()->getCellChanges();
     }
 
     return(false);
 }
 
-// Smell Algorithm Helper: determines whether Goblin can reach the Player
-// N.B. This is almost an exact copy of my Homework 2, Question 3 solution
-bool Goblin::pathExists(int maze[18][70], int sr, int sc, int er, int ec, int dist)
+// Private Helper Function: works out the Goblin's route to the Player from the distance field
+bool Goblin::planRoute(int prow, int pcol)
 {
-    bool solvable = false; // Indicates whether a valid solution exists
-
-    // Declare two queues to keep track of the maze coordinates
-    std::queue<int> rows;
-    std::queue<int> columns;
+    Dungeon* dungeon = getActorDungeon();
+    int cols = dungeon->getCol();
 
-    // Push the current coordinates onto the queue
-    rows.push(sr);
-    columns.push(sc);
+    m_goblinRoute.clear();
+    m_goblinRoutePlayer = -1;
 
-    maze[sr][sc] = dist; // Mark the first cell as visited
+    // Walk down the field from the Goblin, each step to the neighbor closest to the Player
+    int r = row();
+    int c = col();
 
-    while (rows.size() != 0)
+    while (true)
     {
-        dist++; // Increment the distance
-
-        // Retrieve the front coordinate
-        int currentRow = rows.front();
-        int currentCol = columns.front();
+        // Read the neighbors off the Dungeon's shared distance field
+        int northSteps = dungeon->playerDistance(r - 1, c);
+        int southSteps = dungeon->playerDistance(r + 1, c);
+        int westSteps = dungeon->playerDistance(r, c - 1);
+        int eastSteps = dungeon->playerDistance(r, c + 1);
 
-        // Pop off the current coordinates
-        rows.pop();
-        columns.pop();
+        // Each cell is one step further from the Player than its closest neighbor
+        int bestSteps = -1;
+        int neighborSteps[4] = { northSteps, southSteps, westSteps, eastSteps };
 
-        // If the current coordinate is the end coordinate, return true
-        if (currentRow == er && currentCol == ec)
+        for (int i = 0; i < 4; i++)
         {
-            solvable = true;
+            if (neighborSteps[i] != -1 && (bestSteps == -1 || neighborSteps[i] < bestSteps))
+            {
+                bestSteps = neighborSteps[i];
+            }
         }
 
-        // If south is unique, push the coordinates onto the queues and mark as encountered
-        if (maze[currentRow + 1][currentCol] == 0)
+        // From the Goblin itself, the Player must be reachable within the smell distance
+        if (m_goblinRoute.empty() && (bestSteps == -1 || bestSteps + 1 > m_goblinSmellDistance))
         {
-            rows.push(currentRow + 1);
-            columns.push(currentCol);
-            maze[currentRow + 1][currentCol] = dist;
+            return(false);
         }
 
-        // If west is unique, push the coordinates onto the queues and mark as encountered
-        if (maze[currentRow][currentCol - 1] == 0)
+        if (bestSteps == 0)
         {
-            rows.push(currentRow);
-            columns.push(currentCol - 1);
-            maze[currentRow][currentCol - 1] = dist;
+            break; // The next step is onto the Player, so the route is complete
         }
 
-        // If north is unique, push the coordinates onto the queues and mark as encountered
-        if (maze[currentRow - 1][currentCol] == 0)
+        // Choose direction with the minimum distance (ties favor North, South, West, East)
+        if (northSteps == bestSteps)
         {
-            rows.push(currentRow - 1);
-            columns.push(currentCol);
-            maze[currentRow - 1][currentCol] = dist;
+            r--;
         }
-
-        // If east is unique, push the coordinates onto the queues and mark as encountered
-        if (maze[currentRow][currentCol + 1] == 0)
+        else if (southSteps == bestSteps)
+        {
+            r++;
+        }
+        else if (westSteps == bestSteps)
+        {
+            c--;
+        }
+        else // eastSteps == bestSteps
         {
-            rows.push(currentRow);
-            columns.push(currentCol + 1);
-            maze[currentRow][currentCol + 1] = dist;
+            c++;
         }
+
+        m_goblinRoute.push_back(r * cols + c);
     }
 
-    return(solvable);
+    // Keep the next step at the back, so each step taken is a pop
+    std::reverse(m_goblinRoute.begin(), m_goblinRoute.end());
+    m_goblinRoutePlayer = prow * cols + pcol;
+    m_goblinRouteChanges = dungeon->getCellChanges();
+
+    return(true);
 }
 
-// Smell Algorithm Helper: recursively determines the shortest path distance
-int Goblin::shortestPath(int maze[18][70], int er, int ec, int sr, int sc)
+// Private Helper Function: takes the next step of the route, unless it may have changed
+bool Goblin::followRoute(int prow, int pcol, int& deltaRow, int& deltaCol)
 {
-    // Work from the target cell back to the starting cell, moving onto the tiles
-    // that contain the smallest value. In the pathExists() function, if a path
-    // exists, the use of a queue will mark all the adjacent cells with the same 
-    // distance level, meaning that when we work backwards in this function, 
-    // choosing the cells with the lowest value will guarantee that we are
-    // traversing along the shortest grid path. The only catches: the function
-    // must be called correctly, and a path must exist, otherwise this will throw 
-    // up an infinite recursion.
+    Dungeon* dungeon = getActorDungeon();
+    int cols = dungeon->getCol();
+
+    if (m_goblinRoute.empty() || m_goblinRoutePlayer != prow * cols + pcol)
+    {
+        return(false); // There is no route, or the Player has moved off its end
+    }
 
-    int distance = 0;
+    // N.B. The route is a shortest path of the given number of steps. A cell that has been
+    // blocked since only matters if the route runs through it. A cell that has opened can
+    // only shorten a path if a path through it from the Goblin to the Player is no longer
+    // than the route; otherwise it cannot change this step or any later one. Either way,
+    // a switch that does not matter now never will, and need not be looked at again
+    int steps = static_cast<int>(m_goblinRoute.size()) + 1;
+    long long changes = dungeon->getCellChanges();
 
-    if (er != sr || ec != sc)
+    for (long long change = m_goblinRouteChanges; change < changes; change++)
     {
-        int N, S, E, W; // Retrieve the status of the cell in the cardinals direction
-
-        // Booleans indicate whether or not we can move in a given direction
-        bool N1 = true;
-        bool S1 = true;
-        bool E1 = true;
-        bool W1 = true;
-
-        // Retrieve the status of the cardinal directional cells
-        N = maze[er - 1][ec];
-        S = maze[er + 1][ec];
-        E = maze[er][ec + 1];
-        W = maze[er][ec - 1];
-
-        // If the cell is not traversable (i.e. ACTOR, ACTORITEM, or WALL), we set the 
-        // directional boolean to be false. N.B. Walls are represented by 1000.
-        if (N == 1000)
-        {
-            N1 = false;
-        }
-        if (S == 1000)
-        {
-            S1 = false;
-        }
-        if (E == 1000)
-        {
-            E1 = false;
-        }
-        if (W == 1000)
-        {
-            W1 = false;
-        }
+        int cell = dungeon->getChangedCell(change);
 
-        // Move onto the cell with the minimum value (i.e. shortest distance to player)
-        if (N1 && N <= S && N <= E && N <= W)
-        {
-            er--;
-        }
-        else if (S1 && S <= N && S <= E && S <= W)
+        if (cell == -1)
         {
-            er++;
+            return(false); // Too much has changed to be remembered
         }
-        else if (W1 && W <= N && W <= E && W <= S)
+
+        int r = cell / cols;
+        int c = cell % cols;
+
+        if (abs(r - row()) + abs(c - col()) + abs(r - prow) + abs(c - pcol) > steps)
         {
-            ec--;
+            continue; // Too far out of the way to matter
         }
-        else if (E1 && E <= N && E <= W && E <= S)
+
+        int status = dungeon->getStatus(r, c);
+
+        if (status == EMPTY || status == ITEM ||
+            std::find(m_goblinRoute.begin(), m_goblinRoute.end(), cell) != m_goblinRoute.end())
         {
-            ec++;
+            return(false);
         }
-        
-        distance++; // Increment the distance
+    }
+    m_goblinRouteChanges = changes;
+
+    int next = m_goblinRoute.back();
+    m_goblinRoute.pop_back();
+    deltaRow = next / cols - row();
+    deltaCol = next % cols - col();
+
+    return(true);
+}
+
+/////////////////////////////////////
+// Chase Policy Implementation
+/////////////////////////////////////
+
+// Mutator: the monster chases the Player, by the given policy
+// N.B. The templates are defined here, with the only kinds that chase, so every policy
+// is instantiated in this file
+template <int Range, ChaseStep... Order>
+bool Actor::chase(ChasePolicy<Range, Order...>, int drow, int dcol)
+{
+    // N.B. Unlike the player move, drow and dcol represent the monster's coordinates
 
-        distance += shortestPath(maze, er, ec, sr, sc); // Recursively determine shortest path
+    // Obtain the Player's coordinates
+    int prow = m_dungeon->player()->row();
+    int pcol = m_dungeon->player()->col();
+
+    // Calculate the Manhattan Distance
+    int manhattanDist = abs(prow - drow) + abs(pcol - dcol);
+
+    // If Player isn't within the Manhattan Distance, then it is never reachable
+    if (manhattanDist > Range)
+    {
+        return(false);
+    }
+    else if (manhattanDist == 1)
+    {
+        attack(prow, pcol); // Player is directly adjacent, thus attack the Player
+        return(false);
     }
 
-    return(distance);
+    // Take the first step, in the policy's order, that the monster can
+    return(chaseSteps<Order...>(drow, dcol, prow, pcol));
 }
 
-// Smell Algorithm Helper: resets maze for further testing
-void Goblin::resetMaze(int maze[18][70])
+// Private Helper Function: takes the last step of the policy's order, if the monster can
+template <ChaseStep Last>
+bool Actor::chaseSteps(int drow, int dcol, int prow, int pcol)
 {
-    for (int r = 0; r < 18; r++)
+    return(chaseStep<Last>(drow, dcol, prow, pcol));
+}
+
+// Private Helper Function: takes the first step, in order, that the monster can
+template <ChaseStep First, ChaseStep Next, ChaseStep... Rest>
+bool Actor::chaseSteps(int drow, int dcol, int prow, int pcol)
+{
+    return(chaseStep<First>(drow, dcol, prow, pcol) ||
+        chaseSteps<Next, Rest...>(drow, dcol, prow, pcol));
+}
+
+// Private Helper Function: takes the step if it brings the monster closer to the Player
+// along its axis and lands on an open cell, reading the neighbor's status only once
+template <ChaseStep Step>
+bool Actor::chaseStep(int drow, int dcol, int prow, int pcol)
+{
+    int deltaRow = (Step == ChaseStep::North) ? -1 : ((Step == ChaseStep::South) ? 1 : 0);
+    int deltaCol = (Step == ChaseStep::West) ? -1 : ((Step == ChaseStep::East) ? 1 : 0);
+
+    // The step is only closer if the Player lies that way along the step's axis
+    bool closer = (deltaRow != 0) ? (prow - drow) * deltaRow > 0 : (pcol - dcol) * deltaCol > 0;
+
+    if (!closer)
     {
-        for (int c = 0; c < 70; c++)
-        {
-            if (maze[r][c] != 1000)
-            {
-                maze[r][c] = 0;
-            }
-        }
+        return(false);
     }
+
+    int newStatus = m_dungeon->getStatus(drow + deltaRow, dcol + deltaCol);
+
+    if (newStatus != ITEM && newStatus != EMPTY)
+    {
+        return(false);
+    }
+
+    // Set the status of the new cell, then reset the current cell, accordingly
+    m_dungeon->setStatus(drow + deltaRow, dcol + deltaCol, (newStatus == ITEM) ? ACTORITEM : ACTOR);
+    m_dungeon->setStatus(drow, dcol, (m_dungeon->getStatus(drow, dcol) == ACTORITEM) ? ITEM : EMPTY);
+
+    changeCoordinates(deltaRow, deltaCol); // Change the monster's coordinates
+    return(true);
 }
 
 /////////////////////////////////////
@@ -1237,22 +1219,30 @@ Bogeyman::Bogeyman(Dungeon* d, int sr, int sc)
     : Actor(d, sr, sc)
 {
     // Set Bogeyman's statistics accordingly
-    int hp = randInt(5, 10); // Goblin begins with random hit points from 5-10
+    int hp = getActorDungeon()->rng().randInt(5, 10); // Goblin begins with random hit points from 5-10
     setArmor(2);
-    setDexterity(randInt(2, 3));
+    setDexterity(getActorDungeon()->rng().randInt(2, 3));
     setHP(hp);
     setMaxHP(hp);
-    setStrength(randInt(2, 3));
-    setActorType("Bogeyman");
+    setStrength(getActorDungeon()->rng().randInt(2, 3));
+    setActorKind(ActorKind::Bogeyman);
     
     // All Bogeymen carry the short sword
-    m_bogeymanWeapon = new Weapon(getActorDungeon(), this, "short sword", -1, -1);
+    m_bogeymanWeapon = getActorDungeon()->arena().create<Weapon>(getActorDungeon(), this,
+        "short sword", -1, -1);
 }
 
 // Bogeyman destructor
 Bogeyman::~Bogeyman()
 {
-    delete m_bogeymanWeapon; // Delete the Bogeyman's Weapon
+    // N.B. The Bogeyman's Weapon lives in the Dungeon's Arena, which destroys it
+}
+
+// Mutator: moves the Bogeyman, and the Weapon it carries, to another Dungeon
+void Bogeyman::setActorDungeon(Dungeon* d)
+{
+    Actor::setActorDungeon(d);
+    m_bogeymanWeapon->setItemDungeon(d);
 }
 
 // Mutator: Bogeyman reads Scroll (does nothing)
@@ -1270,158 +1260,7 @@ bool Bogeyman::wieldWeapon(char)
 // Mutator: the Bogeyman moves
 bool Bogeyman::move(int drow, int dcol)
 {
-    // N.B. Unlike the player move, drow and dcol represent Bogeyman's coordinates
-    
-    // Obtain the Player's coordinates
-    int prow = getActorDungeon()->player()->row();
-    int pcol = getActorDungeon()->player()->col();
-
-    // Calculate the Manhattan Distance
-    int manhattanDist = abs(prow - drow) + abs(pcol - dcol);
-
-    // If Player isn't within the Manhattan Distance, then it is never reachable
-    if (manhattanDist > 5)
-    {
-        return(false);
-    }
-    else if (manhattanDist == 1)
-    {
-        attack(prow, pcol); // Player is directly adjacent, thus attack the Player
-    }
-    else
-    {
-        // Retrieve the Manhattan coordinate distances
-        int manhattanRow = prow - drow;
-        int manhattanCol = pcol - dcol;
-
-        // Retrieve the current and neighboring cell statuses
-        int currStatus = getActorDungeon()->getStatus(drow, dcol);
-        int nStatus = getActorDungeon()->getStatus(drow - 1, dcol);
-        int sStatus = getActorDungeon()->getStatus(drow + 1, dcol);
-        int eStatus = getActorDungeon()->getStatus(drow, dcol + 1);
-        int wStatus = getActorDungeon()->getStatus(drow, dcol - 1);
-
-        // Specify the move cirection
-        int deltaRow = 0; int deltaCol = 0;
-
-        // Bogeyman moves North
-        if (std::abs(prow - (drow - 1)) < std::abs(manhattanRow)
-            && (nStatus == ITEM || nStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (nStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow - 1, dcol, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow - 1, dcol, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaRow = -1;
-            changeCoordinates(deltaRow, deltaCol); // Change Bogeyman's coordinates
-            return(true);
-        }
-
-        // Bogeyman moves South
-        if (std::abs(prow - (drow + 1)) < std::abs(manhattanRow)
-            && (sStatus == ITEM || sStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (sStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow + 1, dcol, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow + 1, dcol, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaRow = 1;
-            changeCoordinates(deltaRow, deltaCol); // Change Bogeyman's coordinates
-            return(true);
-        }
-
-        // Bogeyman moves East
-        if (std::abs(pcol - (dcol + 1)) < std::abs(manhattanCol)
-            && (eStatus == ITEM || eStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (eStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol + 1, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol + 1, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaCol = 1;
-            changeCoordinates(deltaRow, deltaCol); // Change Bogeyman's coordinates
-            return(true);
-        }
-
-        // Bogeyman moves West
-        if (std::abs(pcol - (dcol - 1)) < std::abs(manhattanCol)
-            && (wStatus == ITEM || wStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (wStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol - 1, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol - 1, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaCol = -1;
-            changeCoordinates(deltaRow, deltaCol); // Change Bogeyman's coordinates
-            return(true);
-        }
-    }
-
-    return(false);
+    return(chase(BogeymanChase(), drow, dcol));
 }
 
 /////////////////////////////////////
@@ -1433,22 +1272,30 @@ Snakewoman::Snakewoman(Dungeon* d, int sr, int sc)
     : Actor(d, sr, sc)
 {
     // Set Snakewoman's statistics accordingly
-    int hp = randInt(3, 6); // Snakewoman begins with hit points from 3-6
+    int hp = getActorDungeon()->rng().randInt(3, 6); // Snakewoman begins with hit points from 3-6
     setArmor(3);
     setDexterity(3);
     setHP(hp);
     setMaxHP(hp);
     setStrength(2);
-    setActorType("Snakewoman");
+    setActorKind(ActorKind::Snakewoman);
 
     // All Snakewomen carry the magic fangs of sleep
-    m_snakewomanWeapon = new Weapon(getActorDungeon(), this, "magic fangs", -1, -1);
+    m_snakewomanWeapon = getActorDungeon()->arena().create<Weapon>(getActorDungeon(), this,
+        "magic fangs", -1, -1);
 }
 
 // Snakewoman destructor
 Snakewoman::~Snakewoman()
 {
-    delete m_snakewomanWeapon; // Delete the Snakewoman's Weapon
+    // N.B. The Snakewoman's Weapon lives in the Dungeon's Arena, which destroys it
+}
+
+// Mutator: moves the Snakewoman, and the Weapon it carries, to another Dungeon
+void Snakewoman::setActorDungeon(Dungeon* d)
+{
+    Actor::setActorDungeon(d);
+    m_snakewomanWeapon->setItemDungeon(d);
 }
 
 // Mutator: Snakewoman reads Scroll (does nothing)
@@ -1466,158 +1313,7 @@ bool Snakewoman::wieldWeapon(char)
 // Mutator: the Snakewoman moves
 bool Snakewoman::move(int drow, int dcol)
 {
-    // N.B. Unlike the player move, drow and dcol represent Snakewoman's coordinates
-
-    // Obtain the Player's coordinates
-    int prow = getActorDungeon()->player()->row();
-    int pcol = getActorDungeon()->player()->col();
-
-    // Calculate the Manhattan Distance
-    int manhattanDist = abs(prow - drow) + abs(pcol - dcol);
-
-    // If Player isn't within the Manhattan Distance, then it is never reachable
-    if (manhattanDist > 3)
-    {
-        return(false);
-    }
-    else if (manhattanDist == 1)
-    {
-        attack(prow, pcol); // Player is directly adjacent, thus attack the Player
-    }
-    else
-    {
-        // Retrieve the Manhattan coordinate distances
-        int manhattanRow = prow - drow;
-        int manhattanCol = pcol - dcol;
-
-        // Retrieve the current and neighboring cell statuses
-        int currStatus = getActorDungeon()->getStatus(drow, dcol);
-        int nStatus = getActorDungeon()->getStatus(drow - 1, dcol);
-        int sStatus = getActorDungeon()->getStatus(drow + 1, dcol);
-        int eStatus = getActorDungeon()->getStatus(drow, dcol + 1);
-        int wStatus = getActorDungeon()->getStatus(drow, dcol - 1);
-
-        // Specify the move cirection
-        int deltaRow = 0; int deltaCol = 0;
-
-        // Snakewoman moves North
-        if (std::abs(prow - (drow - 1)) < std::abs(manhattanRow)
-            && (nStatus == ITEM || nStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (nStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow - 1, dcol, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow - 1, dcol, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaRow = -1;
-            changeCoordinates(deltaRow, deltaCol); // Change Snakewoman's coordinates
-            return(true);
-        }
-
-        // Snakewoman moves South
-        if (std::abs(prow - (drow + 1)) < std::abs(manhattanRow)
-            && (sStatus == ITEM || sStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (sStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow + 1, dcol, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow + 1, dcol, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaRow = 1;
-            changeCoordinates(deltaRow, deltaCol); // Change Snakewoman's coordinates
-            return(true);
-        }
-
-        // Snakewoman moves East
-        if (std::abs(pcol - (dcol + 1)) < std::abs(manhattanCol)
-            && (eStatus == ITEM || eStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (eStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol + 1, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol + 1, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaCol = 1;
-            changeCoordinates(deltaRow, deltaCol); // Change Snakewoman's coordinates
-            return(true);
-        }
-
-        // Snakewoman moves West
-        if (std::abs(pcol - (dcol - 1)) < std::abs(manhattanCol)
-            && (wStatus == ITEM || wStatus == EMPTY))
-        {
-            // Set the status of the new cell accordingly
-            if (wStatus == ITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol - 1, ACTORITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol - 1, ACTOR);
-            }
-
-            // Reset the status of the current cell accordingly
-            if (currStatus == ACTORITEM)
-            {
-                getActorDungeon()->setStatus(drow, dcol, ITEM);
-            }
-            else
-            {
-                getActorDungeon()->setStatus(drow, dcol, EMPTY);
-            }
-
-            deltaCol = -1;
-            changeCoordinates(deltaRow, deltaCol); // Change Snakewoman's coordinates
-            return(true);
-        }
-    }
-
-    return(false);
+    return(chase(SnakewomanChase(), drow, dcol));
 }
 
 /////////////////////////////////////
@@ -1628,22 +1324,30 @@ bool Snakewoman::move(int drow, int dcol)
 Dragon::Dragon(Dungeon* d, int sr, int sc)
     : Actor(d, sr, sc)
 {
-    int hp = randInt(20, 25); // Dragon begins with hit points from 20-25
+    int hp = getActorDungeon()->rng().randInt(20, 25); // Dragon begins with hit points from 20-25
     setArmor(4);
     setDexterity(4);
     setHP(hp);
     setMaxHP(hp);
     setStrength(4);
-    setActorType("Dragon");
+    setActorKind(ActorKind::Dragon);
 
     // All Dragons carry the long sword
-    m_dragonWeapon = new Weapon(getActorDungeon(), this, "long sword", -1, -1);
+    m_dragonWeapon = getActorDungeon()->arena().create<Weapon>(getActorDungeon(), this,
+        "long sword", -1, -1);
 }
 
 // Dragon destructor
 Dragon::~Dragon()
 {
-    delete m_dragonWeapon; // Delete the Dragon's Weapon
+    // N.B. The Dragon's Weapon lives in the Dungeon's Arena, which destroys it
+}
+
+// Mutator: moves the Dragon, and the Weapon it carries, to another Dungeon
+void Dragon::setActorDungeon(Dungeon* d)
+{
+    Actor::setActorDungeon(d);
+    m_dragonWeapon->setItemDungeon(d);
 }
 
 // Mutator: Dragon reads Scroll (does nothing)
@@ -20,17 +20,92 @@
  - While some functions may seem to have unintuitive return types (e.g. booleans that are
    not used later), this is deliberately done in order to see the flow of events in the code.
  - All Actors have a pointer to the dungeon they belong to, their character statistics
-   and their type (player, bogeyman, etc.).
+   and their kind (player, bogeyman, etc.).
+ - Actor kinds and statistic categories are enums rather than strings, so that the hot
+   paths (monster turns, attacks, stat changes) branch on integers. What differs between
+   kinds (name, map symbol, weapon) is kept in one table of ActorTraits, indexed by kind.
+ - Once a monster is added to the Dungeon, its statistics and coordinates live in the
+   Dungeon's MonsterStats table (one array per field) rather than in the Actor, so that
+   monster turns can sweep them in tight loops. The accessors and mutators hide this: the
+   Player, and monsters not yet added, keep their statistics in the Actor itself.
  - As protected data members are forbidden, there are some data members that really
    only pertain to the player, and are not accessed unless in reference to the player.
  - The player maintains a personal vector of Item*, which represents its inventory, as 
    well as the index in the inventory of the current weapon it is wielding.
  - All monsters have an Item* pointing to the currently wielded weapon. Only Goblin has
    an additional parameter, which is its smell distance.
+ - A Goblin remembers the route to the Player it last worked out, and keeps following it
+   while the Player stays put and no cell near enough to matter has switched between open
+   and blocked (see Goblin::followRoute()), so that on the many turns where little changes
+   it never reads the distance field at all. It moves exactly as if it had.
+ - Bogeymen and Snakewomen chase the Player greedily, in the same way: they differ only in
+   their ChasePolicy (how far away they give chase, and the order they try their steps
+   in), which is a compile-time parameter of the one Actor::chase(), so each kind gets
+   its own copy with its range and step order built in. A new chasing kind only needs a
+   policy. The range must match the kind's reach in the ActorTraits table, as the
+   monsters' turn only visits monsters with the Player in reach.
 */
 
 class Dungeon; // Indicates to compiler that Dungeon is a class
 class Item; // Indicates to compiler that Dungeon is a class
+struct MonsterStats; // Indicates to compiler that MonsterStats is a struct
+
+// Actor Kinds
+enum class ActorKind
+{
+    Player,
+    Goblin,
+    Bogeyman,
+    Snakewoman,
+    Dragon
+};
+
+// Actor Statistic Categories (for changeStats)
+enum class StatCategory
+{
+    MaxHP,
+    HP,
+    Armor,
+    Strength,
+    Dexterity,
+    Sleep
+};
+
+// The fixed traits of each Actor kind
+struct ActorTraits
+{
+    const char* name; // The kind's name, as shown in messages
+    char symbol; // The kind's symbol on the map
+    int weaponDexterity; // The dexterity bonus of the kind's weapon (monsters only)
+    int weaponDamage; // The damage bonus of the kind's weapon (monsters only)
+    const char* attackVerb; // The kind's attack, as shown in messages (monsters only)
+    int reach; // How far away the kind notices the Player (monsters only)
+};
+
+const ActorTraits& getActorTraits(ActorKind kind); // Retrieve the traits of the kind
+
+// The steps a chasing monster may take
+enum class ChaseStep
+{
+    North,
+    South,
+    East,
+    West
+};
+
+// A chase policy: a monster within Range (Manhattan distance) of the Player attacks it if
+// adjacent, and otherwise takes the first of its steps, in Order, that brings it closer
+// to the Player along the step's axis and lands on an open cell (see Actor::chase())
+template <int Range, ChaseStep... Order>
+struct ChasePolicy
+{
+};
+
+// The chase policies of the monster kinds that chase greedily
+typedef ChasePolicy<5, ChaseStep::North, ChaseStep::South, ChaseStep::East, ChaseStep::West>
+    BogeymanChase;
+typedef ChasePolicy<3, ChaseStep::North, ChaseStep::South, ChaseStep::East, ChaseStep::West>
+    SnakewomanChase;
 
 // Abstract Base Class
 class Actor
@@ -54,15 +129,21 @@ public:
     bool isDead() const; // Retrieve the Actor's dead status
     bool isWinner() const; // Retrieve the Actor's winner status
     Dungeon* getActorDungeon() const; // Retrieve the Actor's dungeon pointer
-    std::string getActorName() const; // Retrieve the Actor's type
-    virtual void dispInventory() const; // Displays the inventory
+    ActorKind getActorKind() const; // Retrieve the Actor's kind
+    std::string getActorName() const; // Retrieve the Actor's kind, as a name
+    virtual int getReach() const; // Retrieve how far away the Actor notices the Player
+    virtual void dispInventory(std::string& frame) const; // Draws the inventory
+    virtual int getInventorySize() const; // Retrieve the number of Items carried
+    virtual const Item* getInventoryItem(int index) const; // Retrieve a carried Item
     
     // Mutator Functions
     void changeCoordinates(int deltaRow, int deltaCol); // Changes the Actor's coordinates
-    void changeStats(int modifier, std::string category); // Changes the Actor's statistics
+    void changeStats(int modifier, StatCategory category); // Changes the Actor's statistics
     virtual bool pickUp(int r, int c, bool gflag); // Actor's pick up Item call
-    void monsterDrop(std::string name); // Creates the Actor's Item drop
+    void monsterDrop(ActorKind kind); // Creates the Actor's Item drop
     virtual bool attack(int r, int c); // Actor (Monster) attack call
+    template <int Range, ChaseStep... Order>
+    bool chase(ChasePolicy<Range, Order...> policy, int drow, int dcol); // Greedy chase
 
     void setArmor(int armor); // Sets the Actor's armor points
     void setDexterity(int dexterity); // Sets the Actor's dexterity points
@@ -71,7 +152,9 @@ public:
     void setSleep(int time); // Sets the Actor's sleep time
     void setStrength(int strength); // Sets the Actor's strength points
 
-    void setActorType(std::string name); // Sets the Actor's type
+    void setActorKind(ActorKind kind); // Sets the Actor's kind
+    virtual void setActorDungeon(Dungeon* d); // Moves the Actor to another Dungeon
+    void setStatSlot(int slot); // Moves the statistics to the Dungeon's monster table row
     void setDead(); // Kills the Actor
     void setWinner(); // Sets the Actor as the winner
 
@@ -81,6 +164,18 @@ public:
     virtual bool wieldWeapon(char c) = 0; // Player wields selected item, if possible
     
 private:
+    // Private Statistic Helper Functions
+    int stat(std::vector<int> MonsterStats::* field, int own) const;
+    int& stat(std::vector<int> MonsterStats::* field, int& own);
+
+    // Private Chase Helper Functions
+    template <ChaseStep Step>
+    bool chaseStep(int drow, int dcol, int prow, int pcol); // Takes the step, if it can
+    template <ChaseStep Last>
+    bool chaseSteps(int drow, int dcol, int prow, int pcol); // Takes the last step, if it can
+    template <ChaseStep First, ChaseStep Next, ChaseStep... Rest>
+    bool chaseSteps(int drow, int dcol, int prow, int pcol); // Takes the first step it can
+
 	int m_acol; // The Actor's column coordinate
 	int m_arow; // The Actor's row coordinate
     int m_armorPoints; // The Actor's armor points
@@ -94,7 +189,8 @@ private:
     bool m_isDead; // The Actor's live status
 
     Dungeon* m_dungeon; // The Actor's Dungeon
-    std::string m_actorType; // The Actor's type
+    ActorKind m_actorKind; // The Actor's kind
+    int m_statSlot; // The Actor's row in the Dungeon's monster table, or -1 if it has none
 };
 
 // Player Derived Class
@@ -107,7 +203,9 @@ public:
 
     // Accessor Functions
     virtual int getWeaponIndex() const; // Retrieve the Player's Weapon index
-    virtual void dispInventory() const; // Displays the Player's inventory
+    virtual void dispInventory(std::string& frame) const; // Draws the Player's inventory
+    virtual int getInventorySize() const; // Retrieve the number of Items the Player carries
+    virtual const Item* getInventoryItem(int index) const; // Retrieve a carried Item
 
     // Mutator Functions
     virtual bool attack(int r, int c); // Calls the Player attack
@@ -115,6 +213,7 @@ public:
     virtual bool pickUp(int r, int c, bool gflag); // Player picks up Item call
     virtual bool readScroll(char c); // Player reads Scroll call
     virtual bool wieldWeapon(char c); // Player wields Weapon call
+    void setInventory(const std::vector<Item*>& items, int weapon); // Replaces the inventory
 private:
     std::vector<Item*> m_inventory; // The Player's inventory of Items
     int m_playerWeapon; // The Player's index of its current Weapon
@@ -128,19 +227,25 @@ public:
     Goblin(Dungeon* d, int sr, int sc, int smellDistance);
     virtual ~Goblin();
 
+    // Accessor Functions
+    virtual int getReach() const; // Retrieve the Goblin's smell distance
+
     // Mutator Functions
     virtual bool readScroll(char c); // Does nothing; only Player can read Scrolls
     virtual bool wieldWeapon(char c); // Does nothing; only Player can wield Weapons
     virtual bool move(int drow, int dcol); // Determines the Goblin's move
-
-    // Smell Algorithm Helper Functions
-    bool pathExists(int maze[18][70], int sr, int sc, int er, int ec, int dist);
-    int shortestPath(int maze[18][70], int er, int ec, int sr, int sc);
-    void resetMaze(int maze[18][70]); // Resets the maze for convenient testing
+    virtual void setActorDungeon(Dungeon* d); // Moves the Goblin and its Weapon
     
 private:
+    // Private Route Helper Functions
+    bool planRoute(int prow, int pcol); // Works out a route from the distance field
+    bool followRoute(int prow, int pcol, int& deltaRow, int& deltaCol); // Takes its next step
+
     Item* m_goblinWeapon; // The Goblin's Weapon
     int m_goblinSmellDistance; // The Goblin's smell distance
+    std::vector<int> m_goblinRoute; // The cells of the Goblin's route, the next one last
+    int m_goblinRoutePlayer; // The Player's cell when the route was worked out, or -1
+    long long m_goblinRouteChanges; // The Dungeon's cell switches the route has allowed for
 };
 
 // Bogeyman Derived Class
@@ -155,6 +260,7 @@ public:
     virtual bool readScroll(char c); // Does nothing; only Player can read Scrolls
     virtual bool wieldWeapon(char c); // Does nothing; only Player can wield Weapons
     virtual bool move(int drow, int dcol); // Determines the Bogeyman's move
+    virtual void setActorDungeon(Dungeon* d); // Moves the Bogeyman and its Weapon
 private:
     Item* m_bogeymanWeapon; // The Bogeyman's Weapon
 };
@@ -171,6 +277,7 @@ public:
     virtual bool readScroll(char c); // Does nothing; only Player can read Scrolls
     virtual bool wieldWeapon(char c); // Does nothing; only Player can wield Weapons
     virtual bool move(int drow, int dcol); // Determines the Snakewoman's move
+    virtual void setActorDungeon(Dungeon* d); // Moves the Snakewoman and its Weapon
 private:
     Item* m_snakewomanWeapon; // The Snakewoman's Weapon
 };
@@ -187,6 +294,7 @@ public:
     virtual bool readScroll(char c); // Does nothing; only Player can read Scrolls
     virtual bool wieldWeapon(char c); // Does nothing; only Player can wield Weapons
     virtual bool move(int drow, int dcol); // Determines the Dragon's move
+    virtual void setActorDungeon(Dungeon* d); // Moves the Dragon and its Weapon
 private:
     Item* m_dragonWeapon; // The Dragon's Weapon
 };
@@ -0,0 +1,112 @@
+// Arena.cpp
+
+#include "Arena.h"
+
+// The default block size; one block holds a typical level's entities
+const std::size_t ARENABLOCKSIZE = 16384;
+
+// Arena default constructor
+Arena::Arena()
+    : Arena(ARENABLOCKSIZE)
+{
+}
+
+// Arena constructor with parameter block size
+Arena::Arena(std::size_t blockSize)
+{
+    m_blockSize = blockSize;
+    m_block = 0;
+    m_offset = 0;
+    m_bytesUsed = 0;
+}
+
+// Arena destructor
+Arena::~Arena()
+{
+    reset(); // Destroy every object still in the Arena
+
+    for (size_t i = 0; i < m_blocks.size(); i++)
+    {
+        delete[] m_blocks[i];
+    }
+}
+
+// Accessor: returns the bytes handed out since the last reset
+std::size_t Arena::getBytesUsed() const
+{
+    return(m_bytesUsed);
+}
+
+// Accessor: returns the number of blocks the Arena holds
+std::size_t Arena::getBlockCount() const
+{
+    return(m_blocks.size() + m_largeBlocks.size());
+}
+
+// Mutator: destroys every object in the Arena, then rewinds to the first block
+void Arena::reset()
+{
+    // Destroy the objects newest first, as later objects may refer to earlier ones
+    for (size_t i = m_destructors.size(); i > 0; i--)
+    {
+        m_destructors[i - 1].destroy(m_destructors[i - 1].object);
+    }
+    m_destructors.clear();
+
+    // Oversized objects had blocks of their own, which are not worth keeping
+    for (size_t i = 0; i < m_largeBlocks.size(); i++)
+    {
+        delete[] m_largeBlocks[i];
+    }
+    m_largeBlocks.clear();
+
+    m_block = 0;
+    m_offset = 0;
+    m_bytesUsed = 0;
+}
+
+// Mutator: exchanges every object and block with the other Arena
+void Arena::swap(Arena& other)
+{
+    std::swap(m_blockSize, other.m_blockSize);
+    m_blocks.swap(other.m_blocks);
+    m_largeBlocks.swap(other.m_largeBlocks);
+    std::swap(m_block, other.m_block);
+    std::swap(m_offset, other.m_offset);
+    std::swap(m_bytesUsed, other.m_bytesUsed);
+    m_destructors.swap(other.m_destructors);
+}
+
+// Private Helper Function: returns suitably aligned memory for an object of the given size
+void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    m_bytesUsed += size;
+
+    // An object larger than a block is given a block of its own
+    // N.B. new[] returns memory aligned for any fundamental type
+    if (size > m_blockSize)
+    {
+        m_largeBlocks.push_back(new char[size]);
+        return(m_largeBlocks.back());
+    }
+
+    // Find room in the current block, moving on to the next block when it is full
+    while (true)
+    {
+        if (m_block == m_blocks.size())
+        {
+            m_blocks.push_back(new char[m_blockSize]);
+        }
+
+        std::size_t start = (m_offset + alignment - 1) / alignment * alignment;
+
+        if (start + size <= m_blockSize)
+        {
+            m_offset = start + size;
+            return(m_blocks[m_block] + start);
+        }
+
+        m_block++;
+        m_offset = 0;
+    }
+}
\ No newline at end of file
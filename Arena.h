@@ -0,0 +1,89 @@
+// Arena.h
+
+#ifndef ARENA_INCLUDED
+#define ARENA_INCLUDED
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+ Arena Design Notes:
+ - Arena is a bump allocator for the entities of one Dungeon level (monsters, their
+   Weapons and the Items lying on the floor). Objects are placed one after another in
+   large blocks, so a level's entities sit together in memory.
+ - Objects are never freed one at a time. reset() runs every destructor (newest first)
+   and rewinds to the start of the first block, so tearing down a level costs one pass
+   and no calls to delete. The blocks are kept and reused by the next level.
+ - Anything that must outlive the level (e.g. an Item the Player picks up) has to be
+   copied out of the Arena before the next reset().
+ - An Arena cannot be copied, as its objects would then be destroyed twice. It can swap
+   its contents with another Arena, so that a level built elsewhere can be taken over.
+*/
+
+class Arena
+{
+public:
+    // Constructors and Destructors
+    Arena(); // Uses the default block size
+    Arena(std::size_t blockSize);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Accessor Functions
+    std::size_t getBytesUsed() const; // Retrieve the bytes handed out since the last reset
+    std::size_t getBlockCount() const; // Retrieve the number of blocks the Arena holds
+
+    // Mutator Functions
+    template <typename T, typename... Args>
+    T* create(Args&&... args); // Constructs a T in the Arena, destroyed on reset()
+    void reset(); // Destroys every object and rewinds, keeping the blocks
+    void swap(Arena& other); // Exchanges the objects and blocks of the two Arenas
+private:
+    // A registered destructor: the function that destroys the object, and the object
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+    };
+
+    // Private Helper Functions
+    void* allocate(std::size_t size, std::size_t alignment);
+    template <typename T>
+    static void destroy(void* object); // Runs T's destructor on the object
+
+    std::size_t m_blockSize; // The size of each block
+    std::vector<char*> m_blocks; // The Arena's blocks, in the order they are filled
+    std::vector<char*> m_largeBlocks; // Blocks holding a single oversized object
+    std::size_t m_block; // The index of the block being filled
+    std::size_t m_offset; // The first free byte of the block being filled
+    std::size_t m_bytesUsed; // The bytes handed out since the last reset
+    std::vector<Destructor> m_destructors; // The destructors to run on reset, oldest first
+};
+
+// Mutator: constructs a T from the arguments in the Arena's memory
+template <typename T, typename... Args>
+T* Arena::create(Args&&... args)
+{
+    void* memory = allocate(sizeof(T), alignof(T));
+    T* object = new (memory) T(std::forward<Args>(args)...);
+
+    // Register the destructor only once the object is fully constructed
+    Destructor entry;
+    entry.destroy = &Arena::destroy<T>;
+    entry.object = object;
+    m_destructors.push_back(entry);
+
+    return(object);
+}
+
+// Private Helper Function: runs T's destructor on the object
+template <typename T>
+void Arena::destroy(void* object)
+{
+    static_cast<T*>(object)->~T();
+}
+
+#endif // ARENA_INCLUDED
\ No newline at end of file
@@ -0,0 +1,763 @@
+// Benchmark.cpp
+
+#include "ActivitySet.h"
+#include "Actor.h"
+#include "Benchmark.h"
+#include "Dungeon.h"
+#include "Game.h"
+#include "Instrument.h"
+#include "Random.h"
+#include "Renderer.h"
+#include "Replay.h"
+#include "Simulator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Reference search: the cell-at-a-time queue search the Bitboard kernel replaces
+static int queueDistance(const Dungeon& d, int sr, int sc, int er, int ec, int limit)
+{
+    // The buffers are reused across calls, clearing only the cells the last search marked
+    static std::vector<int> dist;
+    static std::vector<int> queue;
+    int cols = d.getCol();
+
+    if (dist.size() != static_cast<size_t>(d.getRow() * cols))
+    {
+        dist.assign(d.getRow() * cols, -1);
+    }
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        dist[queue[i]] = -1;
+    }
+    queue.clear();
+
+    if (sr == er && sc == ec)
+    {
+        return(0);
+    }
+
+    dist[sr * cols + sc] = 0;
+    queue.push_back(sr * cols + sc);
+
+    const int deltaRows[4] = { 1, 0, -1, 0 };
+    const int deltaCols[4] = { 0, -1, 0, 1 };
+
+    for (size_t front = 0; front < queue.size(); front++)
+    {
+        int currentRow = queue[front] / cols;
+        int currentCol = queue[front] % cols;
+        int currentDist = dist[queue[front]];
+
+        if (currentDist >= limit)
+        {
+            break;
+        }
+
+        for (int i = 0; i < 4; i++)
+        {
+            int nextRow = currentRow + deltaRows[i];
+            int nextCol = currentCol + deltaCols[i];
+
+            if (nextRow == er && nextCol == ec)
+            {
+                return(currentDist + 1);
+            }
+
+            int state = d.getStatus(nextRow, nextCol);
+
+            if ((state == EMPTY || state == ITEM) && dist[nextRow * cols + nextCol] == -1)
+            {
+                dist[nextRow * cols + nextCol] = currentDist + 1;
+                queue.push_back(nextRow * cols + nextCol);
+            }
+        }
+    }
+
+    return(-1);
+}
+
+// Reference stat change: the category string compares changeStats made before StatCategory
+static void stringChangeStats(Actor* actor, int modifier, std::string category)
+{
+    if (category == "Max HP")
+    {
+        actor->changeStats(modifier, StatCategory::MaxHP);
+    }
+    else if (category == "HP")
+    {
+        actor->changeStats(modifier, StatCategory::HP);
+    }
+    else if (category == "Armor")
+    {
+        actor->changeStats(modifier, StatCategory::Armor);
+    }
+    else if (category == "Strength")
+    {
+        actor->changeStats(modifier, StatCategory::Strength);
+    }
+    else if (category == "Dexterity")
+    {
+        actor->changeStats(modifier, StatCategory::Dexterity);
+    }
+    else if (category == "Sleep")
+    {
+        actor->changeStats(modifier, StatCategory::Sleep);
+    }
+}
+
+// Collects the Dungeon's cells that may hold an Actor (i.e. EMPTY or ITEM), row by row
+static std::vector<int> openCells(const Dungeon& d)
+{
+    std::vector<int> cells;
+    for (int r = 0; r < d.getRow(); r++)
+    {
+        for (int c = 0; c < d.getCol(); c++)
+        {
+            if (d.getStatus(r, c) == EMPTY || d.getStatus(r, c) == ITEM)
+            {
+                cells.push_back(r * d.getCol() + c);
+            }
+        }
+    }
+
+    return(cells);
+}
+
+// Builds a seeded Dungeon of the given size, holding only the Player and the given number
+// of Goblins
+static Dungeon* goblinDungeon(std::uint64_t seed, int smell, int goblins, int rows, int cols)
+{
+    Dungeon* d = new Dungeon(seed % 3, smell, seed, rows, cols);
+
+    // Clear out the monsters the layout generated
+    while (!d->getMonsters().empty())
+    {
+        Actor* monster = d->getMonsters()[0];
+        int state = d->getStatus(monster->row(), monster->col());
+        d->setStatus(monster->row(), monster->col(), (state == ACTORITEM) ? ITEM : EMPTY);
+        d->removeMonster(0);
+    }
+
+    // Place the Player, then the Goblins, each on a distinct open cell
+    std::vector<int> cells = openCells(*d);
+    Random placement(seed);
+    for (int i = 0; i <= goblins && !cells.empty(); i++)
+    {
+        int pick = placement.randInt(cells.size());
+        int r = cells[pick] / d->getCol();
+        int c = cells[pick] % d->getCol();
+        cells[pick] = cells.back();
+        cells.pop_back();
+
+        if (i == 0)
+        {
+            d->addPlayer(r, c);
+            d->setStatus(r, c, (d->getStatus(r, c) == ITEM) ? ACTORITEM : ACTOR);
+            d->player()->setMaxHP(99); // Keep the Player alive for every round
+            d->player()->setHP(99);
+        }
+        else
+        {
+            d->addMonster(d->arena().create<Goblin>(d, r, c, smell));
+        }
+    }
+
+    return(d);
+}
+
+// Benchmark: runs every benchmark
+void Benchmark::runAll()
+{
+    pathSearch(20, 2000, 15);
+    pathSearch(20, 2000, 200);
+    goblinMove(20, 5);
+    render(20, 200);
+    dispatch(200, 1000);
+    levelTransition(20, 200);
+    pregeneration(100);
+    generation(200);
+    turnAllocations(200, 500);
+    saveLoad(200, 300);
+    replay(200, 2000);
+    activity(10, 1000, 500);
+}
+
+// Benchmark: times the Bitboard path search against the queue-based search
+void Benchmark::pathSearch(int dungeons, int queries, int limit)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    long long queueNanos = 0;
+    long long bitboardNanos = 0;
+    long long total = 0;
+    long long reachable = 0;
+    long long disagreements = 0;
+
+    Random random(2024); // Fixed seed, so every run measures the same searches
+
+    for (int i = 0; i < dungeons; i++)
+    {
+        Dungeon d(random.randInt(0, 2), limit, i, DUNGEONROWS, DUNGEONCOLS);
+
+        // Use the traversable cells as search endpoints
+        std::vector<int> cells = openCells(d);
+
+        for (int q = 0; q < queries; q++)
+        {
+            int start = cells[random.randInt(cells.size())];
+            int end = cells[random.randInt(cells.size())];
+            int sr = start / d.getCol(), sc = start % d.getCol();
+            int er = end / d.getCol(), ec = end % d.getCol();
+
+            Clock::time_point t0 = Clock::now();
+            int expected = queueDistance(d, sr, sc, er, ec, limit);
+            Clock::time_point t1 = Clock::now();
+            int actual = d.pathDistance(sr, sc, er, ec, limit);
+            Clock::time_point t2 = Clock::now();
+
+            queueNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            bitboardNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+            total++;
+
+            if (expected != -1)
+            {
+                reachable++;
+            }
+            if (expected != actual)
+            {
+                disagreements++;
+            }
+        }
+    }
+
+    std::cout << "pathSearch limit=" << limit << " queries=" << total
+        << " reachable=" << reachable
+        << " queue=" << queueNanos / total << "ns/query"
+        << " bitboard=" << bitboardNanos / total << "ns/query"
+        << " disagreements=" << disagreements << std::endl;
+}
+
+// Benchmark: times Goblin::move across smell distances and Goblin counts
+void Benchmark::goblinMove(int dungeons, int rounds)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const int smells[] = { 5, 10, 15, 25, 40, 60, 100, 150, 200 };
+    const int goblinCounts[] = { 1, 5, 20, 50 };
+
+    for (int smell : smells)
+    {
+        for (int goblins : goblinCounts)
+        {
+            long long nanos = 0;
+            long long calls = 0;
+            long long builds = 0;
+            long long cells = 0;
+
+            for (int i = 0; i < dungeons; i++)
+            {
+                // The same seeds are used for every setting, so only the setting varies
+                Dungeon* d = goblinDungeon(i + 1, smell, goblins, DUNGEONROWS, DUNGEONCOLS);
+
+                // Each round is one monster phase in which every Goblin moves once
+                for (int round = 0; round < rounds; round++)
+                {
+                    const std::vector<Actor*>& monsters = d->getMonsters();
+
+                    for (size_t m = 0; m < monsters.size(); m++)
+                    {
+                        Clock::time_point t0 = Clock::now();
+                        monsters[m]->move(monsters[m]->row(), monsters[m]->col());
+                        Clock::time_point t1 = Clock::now();
+
+                        nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+                        calls++;
+                    }
+                }
+
+                builds += d->getFieldBuilds();
+                cells += d->getFieldCells();
+                delete d;
+            }
+
+            std::cout << "goblinMove smell=" << smell << " goblins=" << goblins
+                << " calls=" << calls
+                << " time=" << ((calls > 0) ? nanos / calls : 0) << "ns/call"
+                << " builds=" << ((calls > 0) ? double(builds) / calls : 0) << "/call"
+                << " cells=" << ((calls > 0) ? cells / calls : 0) << "/call" << std::endl;
+        }
+    }
+}
+
+// Benchmark: compares full redraws with diffed frames while the Player and Goblins move
+void Benchmark::render(int dungeons, int frames)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const int deltaRows[4] = { 1, 0, -1, 0 };
+    const int deltaCols[4] = { 0, -1, 0, 1 };
+
+    std::ostringstream fullOut;
+    std::ostringstream diffOut;
+    Renderer fullRenderer(fullOut, true);
+    Renderer diffRenderer(diffOut, true);
+    long long fullNanos = 0;
+    long long diffNanos = 0;
+    long long total = 0;
+    Random random(2024); // Fixed seed, so every run draws the same frames
+    std::string frame;
+
+    for (int i = 0; i < dungeons; i++)
+    {
+        Dungeon* d = goblinDungeon(i + 1, 15, 5, DUNGEONROWS, DUNGEONCOLS);
+        diffRenderer.invalidate(); // Each Dungeon starts on a freshly drawn screen
+
+        for (int f = 0; f < frames; f++)
+        {
+            // Step the Player to a random open neighbour, then let every Goblin move
+            int k = random.randInt(4);
+            int prow = d->player()->row();
+            int pcol = d->player()->col();
+            int nrow = prow + deltaRows[k];
+            int ncol = pcol + deltaCols[k];
+
+            if (d->getStatus(nrow, ncol) == EMPTY)
+            {
+                d->setStatus(prow, pcol, (d->getStatus(prow, pcol) == ACTORITEM) ? ITEM : EMPTY);
+                d->player()->changeCoordinates(deltaRows[k], deltaCols[k]);
+                d->setStatus(nrow, ncol, ACTOR);
+            }
+
+            const std::vector<Actor*>& monsters = d->getMonsters();
+            for (size_t m = 0; m < monsters.size(); m++)
+            {
+                monsters[m]->move(monsters[m]->row(), monsters[m]->col());
+            }
+
+            frame.clear();
+            d->display(frame);
+
+            // A full redraw is a Renderer that never keeps the previous frame
+            Clock::time_point t0 = Clock::now();
+            fullRenderer.invalidate();
+            fullRenderer.present(frame);
+            Clock::time_point t1 = Clock::now();
+            diffRenderer.present(frame);
+            Clock::time_point t2 = Clock::now();
+
+            fullNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            diffNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+            total++;
+
+            fullOut.str("");
+            diffOut.str("");
+        }
+
+        delete d;
+    }
+
+    std::cout << "render frames=" << total
+        << " full=" << fullRenderer.getBytesWritten() / total << "B/frame "
+        << fullNanos / total << "ns/frame"
+        << " diff=" << diffRenderer.getBytesWritten() / total << "B/frame "
+        << diffNanos / total << "ns/frame" << std::endl;
+}
+
+// Benchmark: compares the per-monster checks of a monster turn by kind name and by enum
+void Benchmark::dispatch(int dungeons, int rounds)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    long long stringNanos = 0;
+    long long enumNanos = 0;
+    long long turns = 0;
+    long long stringDragons = 0;
+    long long enumDragons = 0;
+    Random random(2024); // Fixed seed, so every run measures the same monsters
+
+    for (int i = 0; i < dungeons; i++)
+    {
+        Dungeon d(random.randInt(0, 4), 15, i, DUNGEONROWS, DUNGEONCOLS);
+        const std::vector<Actor*>& monsters = d.getMonsters();
+
+        // The checks every monster turn makes: the Dragon test, regeneration and sleep
+        // N.B. A zero modifier leaves the statistics unchanged, so every round is the same
+        Clock::time_point t0 = Clock::now();
+        for (int round = 0; round < rounds; round++)
+        {
+            for (size_t m = 0; m < monsters.size(); m++)
+            {
+                if (monsters[m]->getActorName() == "Dragon")
+                {
+                    stringDragons++;
+                    stringChangeStats(monsters[m], 0, "HP");
+                }
+                stringChangeStats(monsters[m], 0, "Sleep");
+            }
+        }
+        Clock::time_point t1 = Clock::now();
+        for (int round = 0; round < rounds; round++)
+        {
+            for (size_t m = 0; m < monsters.size(); m++)
+            {
+                if (monsters[m]->getActorKind() == ActorKind::Dragon)
+                {
+                    enumDragons++;
+                    monsters[m]->changeStats(0, StatCategory::HP);
+                }
+                monsters[m]->changeStats(0, StatCategory::Sleep);
+            }
+        }
+        Clock::time_point t2 = Clock::now();
+
+        stringNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        enumNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        turns += static_cast<long long>(monsters.size()) * rounds;
+    }
+
+    std::cout << "dispatch monsterTurns=" << turns
+        << " string=" << double(stringNanos) / turns << "ns/turn"
+        << " enum=" << double(enumNanos) / turns << "ns/turn"
+        << " dragons=" << stringDragons << "/" << enumDragons << std::endl;
+}
+
+// Benchmark: times Dungeon::newLevel, which tears down one level and generates the next
+void Benchmark::levelTransition(int dungeons, int transitions)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    long long nanos = 0;
+    long long total = 0;
+    long long entities = 0;
+    std::size_t blocks = 0;
+
+    for (int i = 0; i < dungeons; i++)
+    {
+        Dungeon d(0, 15, i, DUNGEONROWS, DUNGEONCOLS);
+        d.addPlayer(1, 1); // N.B. newLevel moves the Player to a valid cell
+
+        for (int t = 0; t < transitions; t++)
+        {
+            Clock::time_point t0 = Clock::now();
+            d.newLevel(t % 3);
+            Clock::time_point t1 = Clock::now();
+
+            nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            entities += d.getMonsters().size() + d.getAvailItems().size();
+            total++;
+        }
+
+        blocks = std::max(blocks, d.arena().getBlockCount());
+    }
+
+    std::cout << "levelTransition transitions=" << total
+        << " time=" << nanos / total << "ns/transition"
+        << " entities=" << double(entities) / total << "/level"
+        << " arenaBlocks=" << blocks << std::endl;
+}
+
+// Benchmark: times the descent to each level, generated on the spot or in the background
+void Benchmark::pregeneration(int dungeons)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const int sizes[][2] = { { DUNGEONROWS, DUNGEONCOLS }, { 100, 300 } };
+
+    for (int s = 0; s < 2; s++)
+    {
+        long long syncNanos = 0;
+        long long stagedNanos = 0;
+        long long transitions = 0;
+
+        for (int i = 0; i < dungeons; i++)
+        {
+            Dungeon sync(0, 15, i, sizes[s][0], sizes[s][1]);
+            Dungeon staged(0, 15, i, sizes[s][0], sizes[s][1]);
+            sync.addPlayer(1, 1); // N.B. newLevel moves the Player to a valid cell
+            staged.addPlayer(1, 1);
+            staged.setPregenerate(true);
+
+            for (int level = 1; level <= IDOLLEVEL; level++)
+            {
+                Clock::time_point t0 = Clock::now();
+                sync.newLevel(level);
+                Clock::time_point t1 = Clock::now();
+
+                // Stand in for the turns spent on the level before the stairway is reached
+                while (!staged.isNextLevelReady())
+                {
+                    std::this_thread::yield();
+                }
+
+                Clock::time_point t2 = Clock::now();
+                staged.newLevel(level);
+                Clock::time_point t3 = Clock::now();
+
+                syncNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+                stagedNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t2).count();
+                transitions++;
+            }
+        }
+
+        std::cout << "pregeneration size=" << sizes[s][0] << "x" << sizes[s][1]
+            << " transitions=" << transitions
+            << " sync=" << syncNanos / transitions << "ns/transition"
+            << " staged=" << stagedNanos / transitions << "ns/transition" << std::endl;
+    }
+}
+
+// Benchmark: times the generation of each level on maps of increasing size
+void Benchmark::generation(int dungeons)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const int sizes[][2] = { { DUNGEONROWS, DUNGEONCOLS }, { 40, 140 }, { 100, 300 } };
+
+    for (int s = 0; s < 3; s++)
+    {
+        long long nanos = 0;
+        long long levels = 0;
+        long long open = 0;
+
+        for (int i = 0; i < dungeons; i++)
+        {
+            // Every level, up to the golden idol's, as the deeper levels want more rooms
+            for (int level = 0; level <= 4; level++)
+            {
+                Clock::time_point t0 = Clock::now();
+                Dungeon d(level, 15, i * 5 + level, sizes[s][0], sizes[s][1]);
+                Clock::time_point t1 = Clock::now();
+
+                nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+                levels++;
+
+                for (int r = 0; r < d.getRow(); r++)
+                {
+                    for (int c = 0; c < d.getCol(); c++)
+                    {
+                        open += (d.getStatus(r, c) != WALLS);
+                    }
+                }
+            }
+        }
+
+        std::cout << "generation size=" << sizes[s][0] << "x" << sizes[s][1]
+            << " levels=" << levels
+            << " time=" << nanos / levels << "ns/level"
+            << " open=" << double(open) / levels << "cells/level" << std::endl;
+    }
+}
+
+// Benchmark: counts the heap allocations made per turn of seeded headless Games
+void Benchmark::turnAllocations(int games, int turns)
+{
+    long long allocations = 0;
+    long long total = 0;
+
+    for (int g = 0; g < games; g++)
+    {
+        Game game(15, g);
+        Random bot(~static_cast<std::uint64_t>(g));
+        int keysLeft = turns;
+        long long before = Instrument::getAllocations();
+
+        // Wander and fight without leaving the level, so that only turns are counted
+        // N.B. Picking up and taking stairways allocate by design (Item copies, new levels)
+        GameResult result = game.runHeadless(Simulator::botKeys(bot, keysLeft, false, false));
+
+        allocations += Instrument::getAllocations() - before;
+        total += result.turns;
+    }
+
+    std::cout << "turnAllocations turns=" << total
+        << " allocations=" << double(allocations) / total << "/turn" << std::endl;
+}
+
+// Benchmark: times saving and loading seeded Games, part way through, to and from a file
+void Benchmark::saveLoad(int games, int turns)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const char* path = "benchmark.sav";
+    long long saveNanos = 0;
+    long long loadNanos = 0;
+    long long bytes = 0;
+    long long total = 0;
+    long long failures = 0;
+
+    for (int g = 0; g < games; g++)
+    {
+        Game game(15, g);
+        Random bot(~static_cast<std::uint64_t>(g));
+        int keysLeft = turns;
+
+        // Wander and pick things up for a while, so that there is something to save
+        game.runHeadless(Simulator::botKeys(bot, keysLeft, false));
+
+        Clock::time_point t0 = Clock::now();
+        bool saved = game.save(path);
+        Clock::time_point t1 = Clock::now();
+        bool loaded = saved && game.load(path);
+        Clock::time_point t2 = Clock::now();
+
+        if (!loaded)
+        {
+            failures++;
+            continue;
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        bytes += file.tellg();
+        saveNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        loadNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        total++;
+    }
+
+    std::remove(path);
+
+    std::cout << "saveLoad games=" << total
+        << " save=" << (total > 0 ? saveNanos / total : 0) << "ns/game"
+        << " load=" << (total > 0 ? loadNanos / total : 0) << "ns/game"
+        << " size=" << (total > 0 ? bytes / total : 0) << "bytes"
+        << " failures=" << failures << std::endl;
+}
+
+// Benchmark: compares checking every monster's reach each turn with the ActivitySet
+void Benchmark::activity(int dungeons, int turns, int monsters)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const int deltaRows[4] = { 1, 0, -1, 0 };
+    const int deltaCols[4] = { 0, -1, 0, 1 };
+
+    long long scanNanos = 0;
+    long long activeNanos = 0;
+    long long scanVisits = 0;
+    long long activeVisits = 0;
+    long long disagreements = 0;
+    long long total = 0;
+    Random random(2024); // Fixed seed, so every run walks the same paths
+    std::vector<unsigned char> inReach;
+
+    for (int i = 0; i < dungeons; i++)
+    {
+        // A large map, with far more Goblins than a level normally holds
+        Dungeon* d = goblinDungeon(i + 1, 15, monsters, 100, 300);
+        d->player()->setMaxHP(99999); // Keep the Player alive for every turn
+        d->player()->setHP(99999);
+
+        ActivitySet active;
+        const MonsterStats& stats = d->monsterStats();
+
+        for (int t = 0; t < turns; t++)
+        {
+            // Step the Player to a random open neighbour
+            int k = random.randInt(4);
+            int status = d->getStatus(d->player()->row() + deltaRows[k],
+                d->player()->col() + deltaCols[k]);
+
+            if (status == EMPTY || status == ITEM)
+            {
+                d->player()->move(deltaRows[k], deltaCols[k]);
+            }
+
+            int prow = d->player()->row();
+            int pcol = d->player()->col();
+            int count = static_cast<int>(stats.kind.size());
+
+            // Every monster's distance checked, as the monsters' turn used to
+            Clock::time_point t0 = Clock::now();
+            inReach.resize(count);
+            for (int m = 0; m < count; m++)
+            {
+                int distance = std::abs(stats.row[m] - prow) + std::abs(stats.col[m] - pcol);
+                inReach[m] = (distance <= stats.reach[m]);
+            }
+            scanVisits += count;
+            Clock::time_point t1 = Clock::now();
+            active.update(stats, prow, pcol, d->getMonsterVersion());
+            activeVisits += active.getVisits().size();
+            Clock::time_point t2 = Clock::now();
+
+            scanNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+            activeNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+            total++;
+
+            // Let the monsters within reach move, so that the set has to follow them
+            const std::vector<int>& visits = active.getVisits();
+            for (size_t v = 0; v < visits.size(); v++)
+            {
+                int m = visits[v];
+
+                if (!inReach[m])
+                {
+                    disagreements++;
+                }
+                d->getMonsters()[m]->move(stats.row[m], stats.col[m]);
+            }
+        }
+
+        delete d;
+    }
+
+    std::cout << "activity monsters=" << monsters << " turns=" << total
+        << " scan=" << scanNanos / total << "ns/turn (" << scanVisits / total << " visits)"
+        << " active=" << activeNanos / total << "ns/turn (" << activeVisits / total << " visits)"
+        << " disagreements=" << disagreements << std::endl;
+}
+
+// Benchmark: records bot Games to replay logs, then times replaying them
+void Benchmark::replay(int games, int turns)
+{
+    const char* path = "benchmark.rec";
+    long long bytes = 0;
+    long long keys = 0;
+    long long replayed = 0;
+    long long mismatches = 0;
+    double seconds = 0;
+
+    for (int g = 0; g < games; g++)
+    {
+        Game game(15, g);
+        Random bot(~static_cast<std::uint64_t>(g));
+        int keysLeft = turns;
+
+        // Cheat once, so that the bot lives long enough to give a realistic workload
+        game.startRecording(path);
+        game.runHeadless(Simulator::botKeys(bot, keysLeft, true));
+        game.stopRecording();
+
+        ReplayResult result = Replay::run(path);
+
+        if (!result.matched)
+        {
+            mismatches++;
+        }
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        bytes += file.tellg();
+        keys += result.keys;
+        replayed += result.turns;
+        seconds += result.seconds;
+    }
+
+    std::remove(path);
+
+    std::cout << "replay games=" << games << " keys=" << keys << " turns=" << replayed
+        << " turnRate=" << static_cast<long long>(seconds > 0 ? replayed / seconds : 0)
+        << "/s size=" << (games > 0 ? bytes / games : 0) << "bytes/log"
+        << " mismatches=" << mismatches << std::endl;
+}
+
+#ifdef MINIROGUE_BENCHMARK
+int main()
+{
+    Benchmark::runAll();
+}
+#endif
\ No newline at end of file
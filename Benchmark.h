@@ -0,0 +1,55 @@
+// Benchmark.h
+
+#ifndef BENCHMARK_INCLUDED
+#define BENCHMARK_INCLUDED
+
+/*
+ Benchmark Design Notes:
+ - Benchmark gathers the timing harnesses used to measure the game's hot paths. It is not
+   part of the game itself: build it in place of main.cpp with MINIROGUE_BENCHMARK defined,
+   which supplies a main() that calls runAll().
+ - Each benchmark builds its own seeded Dungeons, so none of them depend on a Game in
+   progress, and every run measures the same work.
+ - Results are printed to standard output, one line per measurement.
+*/
+
+class Benchmark
+{
+public:
+    static void runAll(); // Runs every benchmark
+
+    // Times the Bitboard path search against a queue-based breadth first search
+    static void pathSearch(int dungeons, int queries, int limit);
+
+    // Times Goblin::move across smell distances and Goblin counts
+    static void goblinMove(int dungeons, int rounds);
+
+    // Compares the bytes and time of full redraws with diffed frames
+    static void render(int dungeons, int frames);
+
+    // Compares monster turn checks made by kind name and stat string against the enums
+    static void dispatch(int dungeons, int rounds);
+
+    // Times level transitions (tearing down one level and generating the next)
+    static void levelTransition(int dungeons, int transitions);
+
+    // Compares the stall of each stairway taken with and without background pregeneration
+    static void pregeneration(int dungeons);
+
+    // Times the generation of every level, at the standard size and on larger maps
+    static void generation(int dungeons);
+
+    // Times saving and loading Games part way through, and reports the size of the files
+    static void saveLoad(int games, int turns);
+
+    // Records Games to replay logs, then times replaying them and checks their final states
+    static void replay(int games, int turns);
+
+    // Compares checking every monster's reach each turn with the ActivitySet, on large maps
+    static void activity(int dungeons, int turns, int monsters);
+
+    // Counts the heap allocations made per turn (counted only with MINIROGUE_BENCHMARK)
+    static void turnAllocations(int games, int turns);
+};
+
+#endif // BENCHMARK_INCLUDED
\ No newline at end of file
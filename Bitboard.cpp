@@ -0,0 +1,167 @@
+// Bitboard.cpp
+
+#include "Bitboard.h"
+#include <algorithm>
+
+#ifdef _MSC_VER  //  Microsoft Visual C++
+#include <intrin.h>
+#endif
+
+// Bitboard default constructor
+Bitboard::Bitboard()
+{
+    m_rows = 0;
+    m_cols = 0;
+    m_words = 0;
+}
+
+// Bitboard constructor with parameters row and column dimensions
+Bitboard::Bitboard(int rows, int cols)
+{
+    resize(rows, cols);
+}
+
+// Accessor: returns the Bitboard's row dimension
+int Bitboard::getRows() const
+{
+    return(m_rows);
+}
+
+// Accessor: returns the Bitboard's column dimension
+int Bitboard::getCols() const
+{
+    return(m_cols);
+}
+
+// Accessor: returns the Bitboard's number of words per row
+int Bitboard::getWords() const
+{
+    return(m_words);
+}
+
+// Accessor: returns whether the cell's bit is set
+bool Bitboard::test(int r, int c) const
+{
+    return(((m_bits[r * m_words + c / 64] >> (c % 64)) & 1) != 0);
+}
+
+// Accessor: returns the first word of the row
+const std::uint64_t* Bitboard::rowWords(int r) const
+{
+    return(&m_bits[r * m_words]);
+}
+
+// Accessor: returns the index of the lowest set bit in a nonzero word
+int Bitboard::lowestBit(std::uint64_t word)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return(static_cast<int>(index));
+#else
+    return(__builtin_ctzll(word));
+#endif
+}
+
+// Mutator: resizes the Bitboard, clearing every bit
+void Bitboard::resize(int rows, int cols)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_words = (cols + 63) / 64; // Round each row up to a whole number of words
+    m_bits.assign(m_rows * m_words, 0);
+}
+
+// Mutator: sets or clears the cell's bit
+void Bitboard::set(int r, int c, bool value)
+{
+    std::uint64_t mask = std::uint64_t(1) << (c % 64);
+
+    if (value)
+    {
+        m_bits[r * m_words + c / 64] |= mask;
+    }
+    else
+    {
+        m_bits[r * m_words + c / 64] &= ~mask;
+    }
+}
+
+// Mutator: clears every bit in the given range of rows (inclusive)
+void Bitboard::clearRows(int firstRow, int lastRow)
+{
+    for (int i = firstRow * m_words; i < (lastRow + 1) * m_words; i++)
+    {
+        m_bits[i] = 0;
+    }
+}
+
+// Mutator: returns the first word of the row
+std::uint64_t* Bitboard::rowWords(int r)
+{
+    return(&m_bits[r * m_words]);
+}
+
+// Mutator: moves the frontier one step in every direction
+bool Bitboard::expand(const Bitboard& frontier, const Bitboard& open, const Bitboard& visited,
+    int& firstRow, int& lastRow)
+{
+    // N.B. The frontier must be clear outside of firstRow - 1 to lastRow + 1, and all four
+    // Bitboards must share the same dimensions. Only rows firstRow to lastRow are written.
+    // On return, firstRow and lastRow are narrowed to the rows the new frontier reached.
+
+    bool reached = false; // Indicates whether any new cell joined the frontier
+    int reachedFirst = lastRow + 1; // The first row the new frontier reached
+    int reachedLast = firstRow - 1; // The last row the new frontier reached
+
+    for (int r = firstRow; r <= lastRow; r++)
+    {
+        const std::uint64_t* here = frontier.rowWords(r);
+        const std::uint64_t* above = (r > 0) ? frontier.rowWords(r - 1) : nullptr;
+        const std::uint64_t* below = (r < m_rows - 1) ? frontier.rowWords(r + 1) : nullptr;
+        const std::uint64_t* openRow = open.rowWords(r);
+        const std::uint64_t* seenRow = visited.rowWords(r);
+        std::uint64_t* nextRow = rowWords(r);
+
+        for (int w = 0; w < m_words; w++)
+        {
+            // Shifting left moves each cell East; the top bit carries in from the word before
+            std::uint64_t east = here[w] << 1;
+            if (w > 0)
+            {
+                east |= here[w - 1] >> 63;
+            }
+
+            // Shifting right moves each cell West; the low bit carries in from the word after
+            std::uint64_t west = here[w] >> 1;
+            if (w < m_words - 1)
+            {
+                west |= here[w + 1] << 63;
+            }
+
+            // North and South neighbors come straight from the adjacent rows
+            std::uint64_t step = east | west;
+            if (above != nullptr)
+            {
+                step |= above[w];
+            }
+            if (below != nullptr)
+            {
+                step |= below[w];
+            }
+
+            nextRow[w] = step & openRow[w] & ~seenRow[w];
+
+            if (nextRow[w] != 0)
+            {
+                reached = true;
+                reachedFirst = std::min(reachedFirst, r);
+                reachedLast = std::max(reachedLast, r);
+            }
+        }
+    }
+
+    firstRow = reachedFirst;
+    lastRow = reachedLast;
+    return(reached);
+}
\ No newline at end of file
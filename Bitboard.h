@@ -0,0 +1,53 @@
+// Bitboard.h
+
+#ifndef BITBOARD_INCLUDED
+#define BITBOARD_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+/*
+ Bitboard Design Notes:
+ - A Bitboard stores one bit per Dungeon cell, packed row by row into 64-bit words. Each
+   row starts on a fresh word, so a row of 70 columns occupies two words.
+ - The Dungeon keeps a Bitboard of its traversable cells (i.e. EMPTY or ITEM), updated
+   whenever a cell status changes.
+ - The expand() function is the breadth first search kernel: rather than pulling one cell
+   at a time off a queue, it moves an entire frontier one step in all four directions at
+   once using shifts and masks, 64 cells per word operation.
+ - For any functions called with coordinates, our design choice assumes that the higher
+   up code will call these functions appropriately (so less error checking is done).
+*/
+
+class Bitboard
+{
+public:
+    // Constructors and Destructors
+    Bitboard();
+    Bitboard(int rows, int cols);
+
+    // Accessor Functions
+    int getRows() const; // Retrieve the Bitboard's row dimension
+    int getCols() const; // Retrieve the Bitboard's column dimension
+    int getWords() const; // Retrieve the number of words in each row
+    bool test(int r, int c) const; // Retrieve whether the cell's bit is set
+    const std::uint64_t* rowWords(int r) const; // Retrieve the first word of a row
+    static int lowestBit(std::uint64_t word); // Retrieve the index of the lowest set bit
+
+    // Mutator Functions
+    void resize(int rows, int cols); // Resizes the Bitboard and clears every bit
+    void set(int r, int c, bool value); // Sets or clears the cell's bit
+    void clearRows(int firstRow, int lastRow); // Clears every bit in a range of rows
+    std::uint64_t* rowWords(int r); // Retrieve the first word of a row
+
+    // Moves the frontier one step, keeping only open cells not yet visited
+    bool expand(const Bitboard& frontier, const Bitboard& open, const Bitboard& visited,
+        int& firstRow, int& lastRow);
+private:
+    int m_rows; // The Bitboard's row dimension
+    int m_cols; // The Bitboard's column dimension
+    int m_words; // The Bitboard's number of words per row
+    std::vector<std::uint64_t> m_bits; // The Bitboard's packed cells
+};
+
+#endif // BITBOARD_INCLUDED
\ No newline at end of file
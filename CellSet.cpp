@@ -0,0 +1,82 @@
+// CellSet.cpp
+
+#include "CellSet.h"
+#include "Random.h"
+#include <cstddef>
+
+// CellSet default constructor
+CellSet::CellSet()
+{
+}
+
+// Accessor: returns the number of cells in the set
+int CellSet::size() const
+{
+    return(m_members.size());
+}
+
+// Accessor: returns whether the cell is in the set
+bool CellSet::contains(int cell) const
+{
+    return(m_position[cell] != -1);
+}
+
+// Accessor: returns a uniformly random member of the set
+int CellSet::sample(Random& random) const
+{
+    // N.B. By design, assume that the higher code does not sample an empty set
+    return(m_members[random.randInt(0, m_members.size() - 1)]);
+}
+
+// Accessor: returns the cells in the set, in the order sample() picks from
+const std::vector<int>& CellSet::members() const
+{
+    return(m_members);
+}
+
+// Mutator: resizes the set to hold the given number of cells, and empties it
+void CellSet::resize(int cells)
+{
+    m_members.clear();
+    m_position.assign(cells, -1);
+}
+
+// Mutator: adds the cell to the end of the members
+void CellSet::insert(int cell)
+{
+    if (m_position[cell] != -1)
+    {
+        return; // The cell is already a member
+    }
+
+    m_position[cell] = m_members.size();
+    m_members.push_back(cell);
+}
+
+// Mutator: removes the cell, moving the last member into its place
+void CellSet::erase(int cell)
+{
+    int index = m_position[cell];
+
+    if (index == -1)
+    {
+        return; // The cell is not a member
+    }
+
+    int last = m_members.back();
+    m_members[index] = last;
+    m_position[last] = index;
+    m_members.pop_back();
+    m_position[cell] = -1;
+}
+
+// Mutator: removes every cell
+void CellSet::clear()
+{
+    for (std::size_t i = 0; i < m_members.size(); i++)
+    {
+        m_position[m_members[i]] = -1;
+    }
+
+    m_members.clear();
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+// CellSet.h
+
+#ifndef CELLSET_INCLUDED
+#define CELLSET_INCLUDED
+
+#include <vector>
+
+/*
+ CellSet Design Notes:
+ - A CellSet holds a set of Dungeon cells (as indices r * cols + c) so that a uniformly
+   random member can be picked in constant time. This replaces picking random coordinates
+   and retrying until one is suitable, which slows down as the map fills up and never ends
+   once no suitable cell is left.
+ - The members are kept densely packed in an array, in no particular order, and each cell
+   records where it sits in that array (or -1). Inserting appends, and erasing moves the
+   last member into the gap, so both take constant time.
+ - The Dungeon keeps one CellSet per kind of placement, updated whenever a cell status
+   changes.
+*/
+
+class Random; // Indicates to compiler that Random is a class
+
+class CellSet
+{
+public:
+    // Constructors and Destructors
+    CellSet();
+
+    // Accessor Functions
+    int size() const; // Retrieve the number of cells in the set
+    bool contains(int cell) const; // Retrieve whether the cell is in the set
+    int sample(Random& random) const; // Retrieve a uniformly random member (set not empty)
+    const std::vector<int>& members() const; // Retrieve the cells, in their sampling order
+
+    // Mutator Functions
+    void resize(int cells); // Resizes the set to hold cells 0 to cells - 1, and empties it
+    void insert(int cell); // Adds the cell, if it is not already in the set
+    void erase(int cell); // Removes the cell, if it is in the set
+    void clear(); // Removes every cell
+private:
+    std::vector<int> m_members; // The cells in the set, densely packed
+    std::vector<int> m_position; // Each cell's index in m_members, or -1 if not a member
+};
+
+#endif // CELLSET_INCLUDED
\ No newline at end of file
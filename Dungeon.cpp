@@ -2,46 +2,285 @@
 
 #include "Actor.h"
 #include "Dungeon.h"
+#include "Instrument.h"
 #include "Item.h"
-#include "utilities.h"
-#include <iostream>
+#include "SaveFile.h"
+#include <algorithm>
+#include <chrono>
 
-// Dungeon constructor with parameters Game level and Goblin smell distance
-Dungeon::Dungeon(int level, int smellDistance)
+// The smallest room, in columns and rows
+const int MINROOMWIDTH = 5;
+const int MINROOMHEIGHT = 3;
+
+// The number of recent cell switches (open or blocked) the Dungeon remembers
+const int CHANGELOGSIZE = 64;
+
+// Private Helper Function: Returns the save record of an Actor
+static SaveActor saveActor(const Actor* actor)
+{
+	SaveActor record;
+	record.kind = static_cast<int>(actor->getActorKind());
+	record.row = actor->row();
+	record.col = actor->col();
+	record.hp = actor->getHP();
+	record.maxHP = actor->getMaxHP();
+	record.sleep = actor->getSleep();
+	record.dexterity = actor->getDexterity();
+	record.strength = actor->getStrength();
+	record.armor = actor->getArmor();
+	record.reach = actor->getReach();
+	return(record);
+}
+
+// Private Helper Function: Returns the save record of an Item
+static SaveItem saveItem(const Item* item)
+{
+	SaveItem record;
+	record.kind = static_cast<int>(item->getItemKind());
+	record.row = item->getR();
+	record.col = item->getC();
+	record.bonus = item->getScrollBonus();
+	return(record);
+}
+
+// Private Helper Function: Sets an Actor's statistics to those of its save record
+static void restoreStats(Actor* actor, const SaveActor& record)
+{
+	actor->setMaxHP(record.maxHP);
+	actor->setHP(record.hp);
+	actor->setSleep(record.sleep);
+	actor->setDexterity(record.dexterity);
+	actor->setStrength(record.strength);
+	actor->setArmor(record.armor);
+}
+
+// Dungeon constructor with parameters Game level, Goblin smell distance, random seed
+// and dimensions
+Dungeon::Dungeon(int level, int smellDistance, std::uint64_t seed, int rows, int cols)
+	: m_random(seed)
+{
+	INSTRUMENT_PHASE(InstrumentPhase::LevelGeneration);
+
+	// Size the grid and its tables, then generate the Dungeon layout and contents
+	initialize(level, smellDistance, rows, cols);
+	generateLayout(level);
+}
+
+// Dungeon constructor with parameter save file, which restores the saved level and Player
+Dungeon::Dungeon(const SaveFile& save)
+	: m_random(save.header().seed)
+{
+	INSTRUMENT_PHASE(InstrumentPhase::LevelGeneration);
+
+	// N.B. The SaveFile has already checked that its records describe a possible Game
+	const SaveHeader& header = save.header();
+	initialize(header.level, header.smellDistance, header.rows, header.cols);
+
+	// Lay out the grid without its Actors, who are put back below
+	// N.B. The placement sets are filled in their saved order at the end, so only the open
+	// cells are marked here, rather than setting each cell's status in turn
+	const std::uint8_t* grid = save.grid();
+	for (int r = 0; r < m_rows; r++)
+	{
+		for (int c = 0; c < m_cols; c++)
+		{
+			int status = grid[r * m_cols + c];
+
+			if (status == ACTOR)
+			{
+				status = EMPTY;
+			}
+			else if (status == ACTORITEM)
+			{
+				status = ITEM;
+			}
+
+			m_grid[r * m_cols + c] = status;
+			if (status != WALLS)
+			{
+				m_openCells.set(r, c, true);
+			}
+		}
+	}
+
+	// Put the floor Items back, in their saved order
+	const SaveItem* items = save.items();
+	for (int i = 0; i < header.itemCount; i++)
+	{
+		const SaveItem& record = items[i];
+		m_availItems.push_back(restoreItem(record, nullptr));
+		m_itemIndex[record.row * m_cols + record.col] = m_availItems.size() - 1;
+	}
+
+	// Put the Player back, with its statistics and inventory
+	const SaveActor& saved = header.player;
+	Player* player = new Player(this, saved.row, saved.col);
+	m_player = player;
+	setStatus(saved.row, saved.col, getStatus(saved.row, saved.col) == ITEM ? ACTORITEM : ACTOR);
+	restoreStats(player, saved);
+
+	const SaveItem* carried = save.inventory();
+	std::vector<Item*> inventory;
+	for (int i = 0; i < header.inventoryCount; i++)
+	{
+		inventory.push_back(restoreItem(carried[i], player));
+	}
+	player->setInventory(inventory, header.weaponIndex);
+
+	if (header.winner)
+	{
+		player->setWinner();
+	}
+	if (header.dead)
+	{
+		player->setDead();
+	}
+
+	// Put the monsters back, in their saved order, so they take their turns in that order
+	const SaveActor* monsters = save.monsters();
+	for (int i = 0; i < header.monsterCount; i++)
+	{
+		const SaveActor& record = monsters[i];
+		Actor* monster;
+
+		switch (static_cast<ActorKind>(record.kind))
+		{
+			case ActorKind::Goblin:
+				monster = m_arena.create<Goblin>(this, record.row, record.col, record.reach);
+				break;
+			case ActorKind::Bogeyman:
+				monster = m_arena.create<Bogeyman>(this, record.row, record.col);
+				break;
+			case ActorKind::Snakewoman:
+				monster = m_arena.create<Snakewoman>(this, record.row, record.col);
+				break;
+			default: // ActorKind::Dragon
+				monster = m_arena.create<Dragon>(this, record.row, record.col);
+				break;
+		}
+
+		addMonster(monster);
+		restoreStats(monster, record);
+	}
+	m_monsterNum = header.monsterCount;
+
+	// Fill the placement sets in their saved order, so later picks match the saved Game
+	const std::int32_t* actorCells = save.actorCells();
+	m_actorCells.clear();
+	for (int i = 0; i < header.actorCellCount; i++)
+	{
+		m_actorCells.insert(actorCells[i]);
+	}
+
+	const std::int32_t* itemCells = save.itemCells();
+	m_itemCells.clear();
+	for (int i = 0; i < header.itemCellCount; i++)
+	{
+		m_itemCells.insert(itemCells[i]);
+	}
+
+	// Post the Message history again, then mark where the current turns began
+	const SaveMessage* messages = save.messages();
+	for (int i = 0; i < header.messageCount; i++)
+	{
+		const SaveMessage& record = messages[i];
+		m_messages.post(static_cast<MessageId>(record.id), static_cast<ActorKind>(record.actor),
+			static_cast<ItemKind>(record.item), record.amount);
+	}
+	m_messages.resumeTurns(header.playerMessages, header.monsterMessages);
+
+	// Resume the random sequence where the saved Game left off
+	// N.B. Creating the Actors and Items above drew from it, so this must come last
+	m_random.setState(header.randomState);
+}
+
+// Private Helper Function: Sets the Dungeon's data members and sizes its tables, all walls
+void Dungeon::initialize(int level, int smellDistance, int rows, int cols)
 {
 	// Set the Dungeon's data members accordingly
-	m_rows = DUNGEONROWS;
-	m_cols = DUNGEONCOLS;
+	// N.B. Rooms need space to be placed, so the standard size is also the minimum size
+	m_rows = std::max(rows, DUNGEONROWS);
+	m_cols = std::max(cols, DUNGEONCOLS);
 	m_level = level;
 	m_smellDistance = smellDistance;
 	m_player = nullptr; // Player is added by the Game class
+	m_monsterVersion = 0;
+
+	// Initially, no level is built in the background
+	m_pregenerate = false;
+	m_stagedLevel = -1;
+
+	// Initially, the distance field has not been built
+	m_distanceValid = false;
+	m_distanceRow = -1;
+	m_distanceCol = -1;
+	m_fieldBuilds = 0;
+	m_fieldCells = 0;
+
+	// Initially, no cell has switched between traversable and blocked
+	m_cellChanges = 0;
+	m_changedCells.assign(CHANGELOGSIZE, -1);
+
+	// Size the search Bitboards to match the grid
+	m_openCells.resize(m_rows, m_cols);
+	m_frontier.resize(m_rows, m_cols);
+	m_nextFrontier.resize(m_rows, m_cols);
+	m_visited.resize(m_rows, m_cols);
+
+	// Start the grid as solid walls so that status changes are well defined
+	m_grid.assign(m_rows * m_cols, WALLS);
+
+	// Initially, no cell holds a monster or an Item
+	m_monsterIndex.assign(m_rows * m_cols, -1);
+	m_itemIndex.assign(m_rows * m_cols, -1);
+
+	// As every cell is a wall, nothing may be placed anywhere yet
+	m_actorCells.resize(m_rows * m_cols);
+	m_itemCells.resize(m_rows * m_cols);
+	m_monsterNum = 0;
+}
 
-	// Set the Dungeon's output strings accordingly
-	m_playerAttackResult = "";
-	m_playerPickedUpItem = "";
-	m_playerReadScroll = "";
-	m_playerWieldWeapon = "";
-	m_monsterAttackResult = "";
+// Private Helper Function: Recreates a saved Item, on the floor or in the owner's inventory
+Item* Dungeon::restoreItem(const SaveItem& record, Actor* owner)
+{
+	ItemKind kind = static_cast<ItemKind>(record.kind);
+	std::string name = getItemTraits(kind).name;
+	Item* item;
 
-	// Generates the Dungeon layout and sets remaining data members accordingly
-	generateLayout(level);
+	// Floor Items belong to the level's Arena, while the Player's are its own to delete
+	// N.B. Carried Items keep the coordinates they were picked up from, which are unused
+	int r = record.row;
+	int c = record.col;
+
+	if (kind >= ItemKind::Mace && kind <= ItemKind::MagicFangs)
+	{
+		item = (owner == nullptr) ? m_arena.create<Weapon>(this, nullptr, name, r, c) :
+			new Weapon(this, owner, name, r, c);
+	}
+	else if (kind >= ItemKind::Teleportation && kind <= ItemKind::EnhanceDexterity)
+	{
+		item = (owner == nullptr) ? m_arena.create<Scroll>(this, nullptr, name, r, c) :
+			new Scroll(this, owner, name, r, c);
+		item->setScrollBonus(record.bonus); // In place of the bonus it just rolled
+	}
+	else // ItemKind::Stairway or ItemKind::GoldenIdol
+	{
+		item = m_arena.create<SpecialItem>(this, nullptr, name, r, c);
+	}
+
+	return(item);
 }
 
 // Dungeon destructor
 Dungeon::~Dungeon()
 {	
-	// Delete Dungeon's vector of available items
-	for (size_t i = 0; i < m_availItems.size(); i++)
-	{
-		delete m_availItems[i];
-	}
-
-	// Delete Dungeon's vector of monsters
-	for (size_t i = 0; i < m_monsterList.size(); i++)
+	// Wait for any level still being built in the background, then discard it
+	if (m_staged.valid())
 	{
-		delete m_monsterList[i];
+		delete m_staged.get();
 	}
 
+	// N.B. The available Items and monsters belong to the Arena, which destroys them
 	delete m_player; // Delete Dungeon's player
 }
 
@@ -69,7 +308,7 @@ int Dungeon::getStatus(int r, int c) const
 	// If the coordinates are valid return the cell status
 	if (inBounds(r, c))
 	{
-		return(m_grid[r][c]);
+		return(m_grid[r * m_cols + c]);
 	}
 	else
 	{
@@ -80,47 +319,25 @@ int Dungeon::getStatus(int r, int c) const
 // Accessor: Returns the index of the Dungeon's Actor
 int Dungeon::actorAtPos(int r, int c) const
 {
-	int correctIndex = -1; // Initially, assume an invalid index
-
-	// Loop through the monsters vector, checking for matching coordinates
-	for (size_t i = 0; i < m_monsterList.size(); i++)
+	// If the coordinates are not valid, no Actor can be there
+	if (!inBounds(r, c))
 	{
-		// Retrieve the Actor's coordinates
-		int monsterr = m_monsterList[i]->row();
-		int monsterc = m_monsterList[i]->col();
-
-		// If the Actor is the target, return the correct index
-		if (monsterr == r && monsterc == c)
-		{
-			correctIndex = i;
-			break;
-		}
+		return(-1);
 	}
 
-	return(correctIndex); // Return the vector index of the Actor, if it exists
+	return(m_monsterIndex[r * m_cols + c]); // Return the vector index of the Actor, if it exists
 }
 
-// Accessor: Rreturns the index of the Dungeon's Item
+// Accessor: Returns the index of the Dungeon's Item
 int Dungeon::itemAtPos(int r, int c) const
 {
-	int correctIndex = -1; // Initially, assume an invalid index
-
-	// Loop through the Items vector, checking for matching coordinates
-	for (size_t i = 0; i < m_availItems.size(); i++)
+	// If the coordinates are not valid, no Item can be there
+	if (!inBounds(r, c))
 	{
-		// Retrieve the Actor's coordinates
-		int itemr = m_availItems[i]->getR();
-		int itemc = m_availItems[i]->getC();
-
-		// If the Item is the target, return the correct index
-		if (itemr == r && itemc == c)
-		{
-			correctIndex = i;
-			break;
-		}
+		return(-1);
 	}
 
-	return(correctIndex); // Return the vector index of the Item, if it exists
+	return(m_itemIndex[r * m_cols + c]); // Return the vector index of the Item, if it exists
 }
 
 // Accessor: Checks if the coordinates are valid
@@ -136,13 +353,120 @@ bool Dungeon::inBounds(int r, int c) const
 	}
 }
 
-// Accessor: Displays the Dungeon status
-void Dungeon::display() const
+// Accessor: Returns the cell's path distance to the Player
+int Dungeon::playerDistance(int r, int c) const
+{
+	// N.B. Only cells within the smell distance of the Player are marked; all others
+	// (including walls and other Actors) return -1
+
+	if (!inBounds(r, c) || m_player == nullptr)
+	{
+		return(-1); // While this should never trigger, it safeguards against bad calls
+	}
+
+	// Rebuild the field if the walkable cells or the Player have changed since the last build
+	if (!m_distanceValid || m_distanceRow != m_player->row() || m_distanceCol != m_player->col())
+	{
+		buildDistanceField();
+	}
+
+	return(m_playerDistance[r * m_cols + c]);
+}
+
+// Accessor: Returns the path distance between two cells, or -1 if not within the limit
+int Dungeon::pathDistance(int sr, int sc, int er, int ec, int limit) const
+{
+	// N.B. The end cell need not be traversable itself (e.g. it may hold the Player)
+
+	if (!inBounds(sr, sc) || !inBounds(er, ec))
+	{
+		return(-1); // While this should never trigger, it safeguards against bad calls
+	}
+
+	if (sr == er && sc == ec)
+	{
+		return(0);
+	}
+
+	// Start the search from the first cell
+	resetFrontier();
+	m_frontier.set(sr, sc, true);
+	m_visited.set(sr, sc, true);
+	int frontierFirst = sr; // The first row the frontier occupies
+	int frontierLast = sr; // The last row the frontier occupies
+
+	for (int dist = 0; dist < limit; dist++)
+	{
+		// If the frontier touches the end cell, it is reached on the next step
+		if ((er > 0 && m_frontier.test(er - 1, ec)) ||
+			(er < m_rows - 1 && m_frontier.test(er + 1, ec)) ||
+			(ec > 0 && m_frontier.test(er, ec - 1)) ||
+			(ec < m_cols - 1 && m_frontier.test(er, ec + 1)))
+		{
+			return(dist + 1);
+		}
+
+		// The frontier can only spread one row further in each direction
+		int firstRow = std::max(0, frontierFirst - 1);
+		int lastRow = std::min(m_rows - 1, frontierLast + 1);
+
+		if (!m_nextFrontier.expand(m_frontier, m_openCells, m_visited, firstRow, lastRow))
+		{
+			return(-1); // The frontier has died out, thus the end cell is unreachable
+		}
+
+		advanceFrontier(frontierFirst, frontierLast, firstRow, lastRow);
+		frontierFirst = firstRow;
+		frontierLast = lastRow;
+	}
+
+	return(-1); // The end cell is further away than the limit
+}
+
+// Accessor: Returns the number of times the distance field has been built
+long long Dungeon::getFieldBuilds() const
 {
-	// Initialize our output grid
-	char displayGrid[DUNGEONROWS][DUNGEONCOLS];
+	return(m_fieldBuilds);
+}
+
+// Accessor: Returns the number of cells marked across all distance field builds
+long long Dungeon::getFieldCells() const
+{
+	return(m_fieldCells);
+}
+
+// Accessor: Returns the number of cells that have switched between traversable and blocked
+long long Dungeon::getCellChanges() const
+{
+	return(m_cellChanges);
+}
+
+// Accessor: Returns the cell of the given switch, or -1 if it is too old to be remembered
+int Dungeon::getChangedCell(long long change) const
+{
+	if (change < 0 || change >= m_cellChanges || change < m_cellChanges - CHANGELOGSIZE)
+	{
+		return(-1);
+	}
 
-	// Set and display our Dungeon
+	return(m_changedCells[change % CHANGELOGSIZE]);
+}
+
+// Accessor: Returns a count bumped whenever the monster table changes (e.g. a monster dies)
+unsigned Dungeon::getMonsterVersion() const
+{
+	return(m_monsterVersion);
+}
+
+// Accessor: Draws the Dungeon status into the frame buffer
+void Dungeon::display(std::string& frame) const
+{
+	INSTRUMENT_PHASE(InstrumentPhase::Display);
+
+	// Initialize our output row, sized to the Dungeon's width
+	std::string displayRow(m_cols, ' ');
+
+	// Set and draw our Dungeon
 	for (int r = 0; r < m_rows; r++)
 	{
 		for (int c = 0; c < m_cols; c++)
@@ -153,7 +477,7 @@ void Dungeon::display() const
 			// Set the output grid appropriately
 			if (state == EMPTY)
 			{
-				displayGrid[r][c] = ' '; // Display an empty cell
+				displayRow[c] = ' '; // Display an empty cell
 			}
 			else if (state == ACTOR || state == ACTORITEM)
 			{
@@ -163,29 +487,12 @@ void Dungeon::display() const
 				if (actorIndex == -1)
 				{
 					// This is the Player, as it is not in the monsters list
-					displayGrid[r][c] = '@'; // Display the Player
+					displayRow[c] = '@'; // Display the Player
 				}
 				else
 				{
-					// Retrieve the type of monster present
-					std::string actorClass = m_monsterList[actorIndex]->getActorName();
-
-					if (actorClass == "Goblin")
-					{
-						displayGrid[r][c] = 'G'; // Display the Goblin
-					}
-					else if (actorClass == "Bogeyman")
-					{
-						displayGrid[r][c] = 'B'; // Display the Bogeyman
-					}
-					else if (actorClass == "Snakewoman")
-					{
-						displayGrid[r][c] = 'S'; // Display the Snakewoman
-					}
-					else if (actorClass == "Dragon")
-					{
-						displayGrid[r][c] = 'D'; // Display the Dragon
-					}
+					// Display the monster's symbol (e.g. 'G' for the Goblin)
+					displayRow[c] = getActorTraits(m_monsterStats.kind[actorIndex]).symbol;
 				}
 			}
 			else if (state == ITEM)
@@ -195,35 +502,36 @@ void Dungeon::display() const
 				if (itemClassIndex != -1)
 				{
 					// Retrieve the type of Item present
-					std::string itemClass = m_availItems[itemClassIndex]->getType();
+					const std::string& itemClass = m_availItems[itemClassIndex]->getType();
 
 					if (itemClass == "Weapon")
 					{
-						displayGrid[r][c] = ')'; // Display the weapon
+						displayRow[c] = ')'; // Display the weapon
 					}
 					else if (itemClass == "Scroll")
 					{
-						displayGrid[r][c] = '?'; // Display the Scroll
+						displayRow[c] = '?'; // Display the Scroll
 					}
 					else if (itemClass == "Stairway")
 					{
-						displayGrid[r][c] = '>'; // Display the Stairway
+						displayRow[c] = '>'; // Display the Stairway
 					}
 					else if (itemClass == "Golden Idol")
 					{
-						displayGrid[r][c] = '&'; // Display the Golden Idol
+						displayRow[c] = '&'; // Display the Golden Idol
 					}
 				}
 			}
 			else
 			{
-				displayGrid[r][c] = '#'; // Display the wall
+				displayRow[c] = '#'; // Display the wall
 			}
 
-			// Output display character to the screen
-			std::cout << displayGrid[r][c];
 		}
-		std::cout << std::endl;
+
+		// Add the display row to the frame
+		frame += displayRow;
+		frame += '\n';
 	}
 
 	// Retrieve the Player's hit points level
@@ -235,33 +543,79 @@ void Dungeon::display() const
 	}
 
 	// Display Player's statistics
-	std::cout << "Dungeon Level: " << m_level << ", Hit Points: "
-		<< currentHP << ", Armor: " << m_player->getArmor()
-		<< ", Strength: " << m_player->getStrength() << ", Dexterity: "
-		<< m_player->getDexterity() << std::endl;
-	std::cout << std::endl;
+	frame += "Dungeon Level: " + std::to_string(m_level) + ", Hit Points: "
+		+ std::to_string(currentHP) + ", Armor: " + std::to_string(m_player->getArmor())
+		+ ", Strength: " + std::to_string(m_player->getStrength()) + ", Dexterity: "
+		+ std::to_string(m_player->getDexterity()) + "\n";
+	frame += '\n';
+
+	// Display the Messages of the current turn, when appropriate
+	m_messages.display(frame);
+}
 
-	// Display the result strings, when appropriate
-	if (m_playerAttackResult != "")
-	{
-		std::cout << m_playerAttackResult << std::endl;
-	}
-	if (m_playerPickedUpItem != "")
+// Accessor: Gathers everything needed to restore the Dungeon (and its Player) into the data
+void Dungeon::save(SaveData& data) const
+{
+	SaveHeader& header = data.header;
+	header = SaveHeader();
+	header.seed = m_random.getSeed();
+	header.randomState = m_random.getState();
+	header.rows = m_rows;
+	header.cols = m_cols;
+	header.level = m_level;
+	header.smellDistance = m_smellDistance;
+
+	// The Player, with its inventory
+	header.player = saveActor(m_player);
+	header.winner = m_player->isWinner();
+	header.dead = m_player->isDead();
+	header.weaponIndex = m_player->getWeaponIndex();
+
+	data.inventory.clear();
+	for (int i = 0; i < m_player->getInventorySize(); i++)
 	{
-		std::cout << m_playerPickedUpItem << std::endl;
+		data.inventory.push_back(saveItem(m_player->getInventoryItem(i)));
 	}
-	if (m_playerWieldWeapon != "")
+
+	// The level's monsters and floor Items, in order
+	data.monsters.clear();
+	for (size_t i = 0; i < m_monsterList.size(); i++)
 	{
-		std::cout << m_playerWieldWeapon << std::endl;
+		data.monsters.push_back(saveActor(m_monsterList[i]));
 	}
-	if (m_playerReadScroll != "")
+
+	data.items.clear();
+	for (size_t i = 0; i < m_availItems.size(); i++)
 	{
-		std::cout << m_playerReadScroll << std::endl;
+		data.items.push_back(saveItem(m_availItems[i]));
 	}
-	if (m_monsterAttackResult != "")
+
+	// The placement sets, in sampling order, and the grid
+	data.actorCells.assign(m_actorCells.members().begin(), m_actorCells.members().end());
+	data.itemCells.assign(m_itemCells.members().begin(), m_itemCells.members().end());
+	data.grid.assign(m_grid.begin(), m_grid.end());
+
+	// The Message history, oldest first
+	data.messages.clear();
+	for (int age = m_messages.size() - 1; age >= 0; age--)
 	{
-		std::cout << m_monsterAttackResult << std::endl;
+		const Message& message = m_messages.recent(age);
+		SaveMessage record;
+		record.id = static_cast<int>(message.id);
+		record.actor = static_cast<int>(message.actor);
+		record.item = static_cast<int>(message.item);
+		record.amount = message.amount;
+		data.messages.push_back(record);
 	}
+	header.playerMessages = m_messages.playerTurnSize();
+	header.monsterMessages = m_messages.monsterTurnSize();
+}
+
+// Accessor: Returns whether the next level has been built in the background, ready to use
+bool Dungeon::isNextLevelReady() const
+{
+	return(m_staged.valid() &&
+		m_staged.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
 }
 
 // Accessor: Returns the Dungeon's Player pointer
@@ -270,18 +624,63 @@ Actor* Dungeon::player() const
 	return(m_player);
 }
 
+// Accessor: Returns the Dungeon's random number context
+Random& Dungeon::rng()
+{
+	return(m_random);
+}
+
+// Accessor: Returns the Dungeon's storage for the level's monsters and Items
+Arena& Dungeon::arena()
+{
+	return(m_arena);
+}
+
+// Accessor: Returns the Dungeon's Message log
+MessageLog& Dungeon::messages()
+{
+	return(m_messages);
+}
+
 // Accessor: Returns the Dungeon's vector of available Items
-std::vector<Item*> Dungeon::getAvailItems() const
+const std::vector<Item*>& Dungeon::getAvailItems() const
 {
 	return(m_availItems);
 }
 
 // Accessor: Returns the Dungeon's vector of available monsters
-std::vector<Actor*> Dungeon::getMonsters() const
+const std::vector<Actor*>& Dungeon::getMonsters() const
 {
 	return(m_monsterList);
 }
 
+// Mutator: Empties every field of the monster statistics table, keeping the storage
+void MonsterStats::clear()
+{
+	row.clear();
+	col.clear();
+	hp.clear();
+	maxHP.clear();
+	sleep.clear();
+	dexterity.clear();
+	strength.clear();
+	armor.clear();
+	reach.clear();
+	kind.clear();
+}
+
+// Accessor: Returns the Dungeon's table of monster statistics
+const MonsterStats& Dungeon::monsterStats() const
+{
+	return(m_monsterStats);
+}
+
+// Accessor: Returns the Dungeon's table of monster statistics, to be modified
+MonsterStats& Dungeon::monsterStats()
+{
+	return(m_monsterStats);
+}
+
 // Mutator: Adds the Dungeon's Player
 bool Dungeon::addPlayer(int r, int c)
 {
@@ -304,6 +703,50 @@ bool Dungeon::addPlayer(int r, int c)
 	return(true);
 }
 
+// Mutator: Adds a monster to the Dungeon
+bool Dungeon::addMonster(Actor* monster)
+{
+	// N.B. By design, assume that the higher code calls appropriately
+
+	int r = monster->row();
+	int c = monster->col();
+
+	// If the cell cannot hold another Actor, return false
+	if (getStatus(r, c) != EMPTY && getStatus(r, c) != ITEM)
+	{
+		return(false);
+	}
+
+	m_monsterList.push_back(monster);
+	m_monsterIndex[r * m_cols + c] = m_monsterList.size() - 1;
+
+	// Move the monster's statistics into the table, where they live from now on
+	m_monsterStats.row.push_back(r);
+	m_monsterStats.col.push_back(c);
+	m_monsterStats.hp.push_back(monster->getHP());
+	m_monsterStats.maxHP.push_back(monster->getMaxHP());
+	m_monsterStats.sleep.push_back(monster->getSleep());
+	m_monsterStats.dexterity.push_back(monster->getDexterity());
+	m_monsterStats.strength.push_back(monster->getStrength());
+	m_monsterStats.armor.push_back(monster->getArmor());
+	m_monsterStats.reach.push_back(monster->getReach());
+	m_monsterStats.kind.push_back(monster->getActorKind());
+	monster->setStatSlot(m_monsterList.size() - 1);
+	m_monsterVersion++;
+
+	// Set monster's Dungeon cell status
+	if (getStatus(r, c) == ITEM)
+	{
+		setStatus(r, c, ACTORITEM);
+	}
+	else
+	{
+		setStatus(r, c, ACTOR);
+	}
+
+	return(true);
+}
+
 // Mutator: Adds a random Item to the Dungeon
 bool Dungeon::addrandItem(int r, int c, bool sflag, bool gflag)
 {
@@ -320,41 +763,44 @@ bool Dungeon::addrandItem(int r, int c, bool sflag, bool gflag)
 	if (!sflag)
 	{
 		// Randomly choose an index for a Weapon/Scroll
-		int weaponClass = randInt(0, 2); // Only 3 Weapons are randomly available
-		int scrollClass = randInt(0, 3); // Only 4 Scrolls are randomly available
+		int weaponClass = m_random.randInt(0, 2); // Only 3 Weapons are randomly available
+		int scrollClass = m_random.randInt(0, 3); // Only 4 Scrolls are randomly available
 
 		std::string weaponType[3] = { "short sword", "long sword", "mace" };
 		std::string scrollType[4] = { "improve armor", "strength",
 		"enhance health", "enhance dexterity" };
 
 		// Determines whether we add a Weapon or Scroll
-		bool isWeapon = trueWithProbability(0.5);
+		bool isWeapon = m_random.trueWithProbability(0.5);
 		Item* someItem;
 
 		if (isWeapon)
 		{
-			someItem = new Weapon(this, nullptr, weaponType[weaponClass], r, c);
+			someItem = m_arena.create<Weapon>(this, nullptr, weaponType[weaponClass], r, c);
 		}
 		else
 		{
-			someItem = new Scroll(this, nullptr, scrollType[scrollClass], r, c);
+			someItem = m_arena.create<Scroll>(this, nullptr, scrollType[scrollClass], r, c);
 		}
 
 		m_availItems.push_back(someItem); // Adds Item to Dungeon's vector of available Items
+		m_itemIndex[r * m_cols + c] = m_availItems.size() - 1;
 		return(true);
 	}
 	else if (sflag && !gflag)
 	{
 		// Adds the stairway to the Dungeon
-		Item* stairwell = new SpecialItem(this, nullptr, "Stairway", r, c);
+		Item* stairwell = m_arena.create<SpecialItem>(this, nullptr, "Stairway", r, c);
 		m_availItems.push_back(stairwell);
+		m_itemIndex[r * m_cols + c] = m_availItems.size() - 1;
 		return(true);
 	}
 	else
 	{
 		// Adds the Golden Idol to the Dungeon
-		Item* goldenIdol = new SpecialItem(this, nullptr, "Golden Idol", r, c);
+		Item* goldenIdol = m_arena.create<SpecialItem>(this, nullptr, "Golden Idol", r, c);
 		m_availItems.push_back(goldenIdol);
+		m_itemIndex[r * m_cols + c] = m_availItems.size() - 1;
 		return(true);
 	}
 
@@ -381,59 +827,60 @@ void Dungeon::addDrop(int r, int c, std::string name, std::string weaponClass)
 	Item* droppedItem;
 	if (weaponClass == "Weapon")
 	{
-		droppedItem = new Weapon(this, nullptr, name, r, c);
+		droppedItem = m_arena.create<Weapon>(this, nullptr, name, r, c);
 	}
 	else
 	{
-		droppedItem = new Scroll(this, nullptr, name, r, c);
+		droppedItem = m_arena.create<Scroll>(this, nullptr, name, r, c);
 	}
 
 	m_availItems.push_back(droppedItem);
+	m_itemIndex[r * m_cols + c] = m_availItems.size() - 1;
 	setStatus(r, c, ITEM); // If drop occurs, the monster dies, thus the status is ITEM
 }
 
 // Mutator: Generates unique Dungeon layout
 void Dungeon::generateLayout(int level)
 {
-	int rectangleNum = randInt(4, level + 4); // Dungeons contain at least four rooms
+	int rectangleNum = m_random.randInt(4, level + 4); // Dungeons contain at least four rooms
 
 	// Vectors are used below to keep track of room coordinates
 	std::vector<int> roomRows;
 	std::vector<int> roomCols;
 
 	// Initialize the Dungeon to be all walls, then "eat out" the rooms appropriately
-	for (int r = 0; r < m_rows; r++)
-	{
-		for (int c = 0; c < m_cols; c++)
-		{
-			setStatus(r, c, WALLS);
-		}
-	}
+	// N.B. A wall is neither traversable nor free for placement, so rather than setting
+	// each cell in turn, the grid, the open cells and the placement sets are reset at once
+	std::fill(m_grid.begin(), m_grid.end(), WALLS);
+	m_openCells.clearRows(0, m_rows - 1);
+	m_actorCells.clear();
+	m_itemCells.clear();
+	m_distanceValid = false;
+
+	// Rooms may be placed anywhere inside the outer walls (with a wall row and column spare)
+	LayoutRect inside = { 1, 1, m_rows - 2, m_cols - 2 };
+	m_freeRects.clear();
+	m_freeRects.push_back(inside);
 
 	// Generate Dungeon rooms
 	while (rectangleNum > 0)
 	{
-		// For each room, generate a suitable coordinate for the top left corner
-		int rowcorner = randInt(1, DUNGEONROWS - 2);
-		int colcorner = randInt(1, DUNGEONCOLS - 2);
-
 		// For each room, generate a suitable size
-		int width = randInt(5, DUNGEONCOLS / 2);
-		int height = randInt(3, DUNGEONROWS / 2);
+		int width = m_random.randInt(MINROOMWIDTH, m_cols / 2);
+		int height = m_random.randInt(MINROOMHEIGHT, m_rows / 2);
 
-		// While the room overlaps with another, keep resetting the room's statistics
-		while (overlap(rowcorner, colcorner, width, height))
-		{
-			rowcorner = randInt(1, DUNGEONROWS - 2);
-			colcorner = randInt(1, DUNGEONCOLS - 2);
+		// Find the room a place among the free rectangles, or stop once there is no space
+		int rowcorner;
+		int colcorner;
 
-			width = randInt(5, DUNGEONCOLS / 2);
-			height = randInt(3, DUNGEONROWS / 2);
+		if (!placeRoom(rowcorner, colcorner, width, height))
+		{
+			break;
 		}
 
 		// Add rows and columns to the vectors to generate corridors later
-		int rowOffset = randInt(0, height / 2);
-		int colOffset = randInt(0, width / 2);
+		int rowOffset = m_random.randInt(0, height / 2);
+		int colOffset = m_random.randInt(0, width / 2);
 		roomRows.push_back(rowcorner + rowOffset); roomCols.push_back(colcorner + colOffset);
 
 		// "Eat out" the Dungeon rooms
@@ -449,7 +896,7 @@ void Dungeon::generateLayout(int level)
 	}
 
 	// Generate a random number of Items per level
-	bool isTwo = trueWithProbability(0.5);
+	bool isTwo = m_random.trueWithProbability(0.5);
 	int itemNum;
 	if (isTwo)
 	{
@@ -463,16 +910,13 @@ void Dungeon::generateLayout(int level)
 	// Place the Items randomly
 	for (int i = 0; i < itemNum; i++)
 	{
-		// Retrieve the coordinates to place Items
-		int randrow = randInt(1, m_rows - 2);
-		int randcol = randInt(1, m_cols - 2);
+		// Retrieve the coordinates to place Items, unless there is nowhere left
+		int randrow;
+		int randcol;
 
-		// While the coordinates are invalid, keep resetting
-		while (getStatus(randrow, randcol) != EMPTY
-			&& getStatus(randrow, randcol) != ACTOR)
+		if (!randomItemCell(randrow, randcol))
 		{
-			randrow = randInt(1, m_rows - 2);
-			randcol = randInt(1, m_cols - 2);
+			break;
 		}
 
 		// Add a random Item to the Dungeon and set cell status accordingly
@@ -481,41 +925,29 @@ void Dungeon::generateLayout(int level)
 	}
 
 	// Check whether to add a stairway or golden idol
-	if (m_level == 4)
+	if (m_level == IDOLLEVEL)
 	{
-		// Retrieve coordinates to place the golden idol
-		int goldrow = randInt(1, m_rows - 2);
-		int goldcol = randInt(1, m_cols - 2);
+		// Retrieve coordinates to place the golden idol, then add it to the Dungeon
+		int goldrow;
+		int goldcol;
 
-		// While the coordinates are invalid, keep resetting
-		while (getStatus(goldrow, goldcol) != EMPTY
-			&& getStatus(goldrow, goldcol) != ACTOR)
+		if (randomItemCell(goldrow, goldcol))
 		{
-			goldrow = randInt(1, m_rows - 2);
-			goldcol = randInt(1, m_cols - 2);
+			addrandItem(goldrow, goldcol, true, true);
+			setStatus(goldrow, goldcol, ITEM);
 		}
-
-		// Adds the golden idol to the Dungeon
-		addrandItem(goldrow, goldcol, true, true);
-		setStatus(goldrow, goldcol, ITEM);
 	}
 	else
 	{
-		// Retrieve coordinates to place the stairwell
-		int stairrow = randInt(1, m_rows - 2);
-		int staircol = randInt(1, m_cols - 2);
+		// Retrieve coordinates to place the stairwell, then add it to the Dungeon
+		int stairrow;
+		int staircol;
 
-		// While the coordinates are invalid, keep resetting
-		while (getStatus(stairrow, staircol) != EMPTY
-			&& getStatus(stairrow, staircol) != ACTOR)
+		if (randomItemCell(stairrow, staircol))
 		{
-			stairrow = randInt(1, m_rows - 2);
-			staircol = randInt(1, m_cols - 2);
+			addrandItem(stairrow, staircol, true, false);
+			setStatus(stairrow, staircol, ITEM);
 		}
-
-		// Adds the stairway to the Dungeon
-		addrandItem(stairrow, staircol, true, false);
-		setStatus(stairrow, staircol, ITEM);
 	}
 
 	// Generate the Dungeon's corridors
@@ -595,30 +1027,28 @@ void Dungeon::generateLayout(int level)
 
 	// Generate a random number of monsters per level
 	int maxMonsters = 5 * (level + 1) + 1;
-	m_monsterNum = randInt(2, maxMonsters);
+	m_monsterNum = m_random.randInt(2, maxMonsters);
 
 	// Place the monsters randomly
 	for (int i = 0; i < m_monsterNum; i++)
 	{
-		// Retrieve the coordinates to place monsters
-		int randrow = randInt(1, m_rows - 2);
-		int randcol = randInt(1, m_cols - 2);
+		// Retrieve the coordinates to place monsters, always leaving a cell for the Player
+		int randrow;
+		int randcol;
 
-		// While the coordinates are invalid, keep resetting
-		while (getStatus(randrow, randcol) != EMPTY
-			&& getStatus(randrow, randcol) != ITEM)
+		if (m_actorCells.size() <= 1 || !randomActorCell(randrow, randcol))
 		{
-			randrow = randInt(1, m_rows - 2);
-			randcol = randInt(1, m_cols - 2);
+			m_monsterNum = i;
+			break;
 		}
 
 		// Determine which monster to add
-		int chooser = randInt(0, level);
+		int chooser = m_random.randInt(0, level);
 
 		// For level zero, we can add either Snakewomen or Goblins
 		if (level == 0)
 		{
-			chooser = randInt(0, 1);
+			chooser = m_random.randInt(0, 1);
 		}
 
 		// Adds the appropriately selected monster
@@ -626,70 +1056,162 @@ void Dungeon::generateLayout(int level)
 		switch (chooser)
 		{
 			case 0:
-				myMonster = new Snakewoman(this, randrow, randcol);
+				myMonster = m_arena.create<Snakewoman>(this, randrow, randcol);
 				break;
 			case 1:
-				myMonster = new Goblin(this, randrow, randcol, m_smellDistance);
+				myMonster = m_arena.create<Goblin>(this, randrow, randcol, m_smellDistance);
 				break;
 			case 2:
-				myMonster = new Bogeyman(this, randrow, randcol);
+				myMonster = m_arena.create<Bogeyman>(this, randrow, randcol);
 				break;
 			default: // We are at level three or higher
-				myMonster = new Dragon(this, randrow, randcol);
+				myMonster = m_arena.create<Dragon>(this, randrow, randcol);
 				break;
 		}
 
-		m_monsterList.push_back(myMonster);
-
-		// Set monster's Dungeon cell status
-		if (getStatus(randrow, randcol) == ITEM)
-		{
-			setStatus(randrow, randcol, ACTORITEM);
-		}
-		else
-		{
-			setStatus(randrow, randcol, ACTOR);
-		}
+		addMonster(myMonster);
 	}
 }
 
-// Mutator: Generates new level if previous level was cleared
-void Dungeon::newLevel(int level)
+// Mutator: Picks a random cell an Actor may be placed on (i.e. EMPTY or ITEM)
+bool Dungeon::randomActorCell(int& r, int& c)
 {
-	// Deletes the vector of available Items
-	for (size_t i = 0; i < m_availItems.size(); i++)
+	if (m_actorCells.size() == 0)
 	{
-		delete m_availItems[i];
+		return(false); // There is no such cell
 	}
 
-	// Deletes the vector of monsters
-	for (size_t i = 0; i < m_monsterList.size(); i++)
+	int cell = m_actorCells.sample(m_random);
+	r = cell / m_cols;
+	c = cell % m_cols;
+	return(true);
+}
+
+// Mutator: Picks a random cell an Item may be placed on (i.e. EMPTY or ACTOR)
+bool Dungeon::randomItemCell(int& r, int& c)
+{
+	if (m_itemCells.size() == 0)
 	{
-		delete m_monsterList[i];
+		return(false); // There is no such cell
 	}
 
-	m_level = level; // Set the new level accordingly
-	m_availItems.clear(); // Reset the vector of available Items
-	m_monsterList.clear(); // Reset the vector of monsters
+	int cell = m_itemCells.sample(m_random);
+	r = cell / m_cols;
+	c = cell % m_cols;
+	return(true);
+}
 
-	// Generate new Dungeon layout
-	generateLayout(level);
+// Mutator: Generates new level if previous level was cleared
+void Dungeon::newLevel(int level)
+{
+	INSTRUMENT_PHASE(InstrumentPhase::NewLevel);
 
-	// Move the Player to a random location
-	int rnew = randInt(1, m_rows - 2);
-	int cnew = randInt(1, m_cols - 2);
+	// Take the level from the background if it was built there, otherwise build it now
+	Dungeon* staged = nullptr;
+
+	if (m_staged.valid())
+	{
+		staged = m_staged.get(); // Waits, if the level is not quite finished
+
+		if (m_stagedLevel != level)
+		{
+			delete staged; // The wrong level was built, so it cannot be used
+			staged = nullptr;
+		}
+	}
 
-	// While the coordinates are invalid, keep resetting
-	while (getStatus(rnew, cnew) != EMPTY && getStatus(rnew, cnew) != ITEM)
+	if (staged == nullptr)
 	{
-		rnew = randInt(1, m_rows - 2);
-		cnew = randInt(1, m_cols - 2);
+		staged = new Dungeon(level, m_smellDistance, levelSeed(level), m_rows, m_cols);
 	}
 
+	// Take over the new Dungeon layout, then destroy the previous level all at once
+	adoptLevel(*staged);
+	delete staged;
+
+	// Move the Player to a random location
+	// N.B. generateLayout always leaves a cell free for the Player
+	int rnew = m_player->row();
+	int cnew = m_player->col();
+	randomActorCell(rnew, cnew);
+
 	// Calculate the difference between the new and current Player coordinates
 	int drow = rnew - m_player->row();
 	int dcol = cnew - m_player->col();
 	m_player->move(drow, dcol);
+
+	// Start building the level below, while this one is played
+	if (m_pregenerate && level < IDOLLEVEL)
+	{
+		startPregeneration(level + 1);
+	}
+}
+
+// Mutator: Determines whether each next level is built in the background
+void Dungeon::setPregenerate(bool enabled)
+{
+	m_pregenerate = enabled;
+
+	if (m_pregenerate && !m_staged.valid() && m_level < IDOLLEVEL)
+	{
+		startPregeneration(m_level + 1);
+	}
+}
+
+// Private Helper Function: Returns the seed the level is generated from
+std::uint64_t Dungeon::levelSeed(int level) const
+{
+	// N.B. Random scrambles its seed, so spacing the levels apart is enough
+	return(m_random.getSeed() + 0x9E3779B97F4A7C15ULL * (level + 1));
+}
+
+// Private Helper Function: Starts building the level as a staging Dungeon on a worker thread
+void Dungeon::startPregeneration(int level)
+{
+	// N.B. The staging Dungeon shares nothing with this one, so no locking is needed
+	int smellDistance = m_smellDistance;
+	std::uint64_t seed = levelSeed(level);
+	int rows = m_rows;
+	int cols = m_cols;
+
+	m_stagedLevel = level;
+	m_staged = std::async(std::launch::async, [level, smellDistance, seed, rows, cols]()
+	{
+		return(new Dungeon(level, smellDistance, seed, rows, cols));
+	});
+}
+
+// Private Helper Function: Exchanges levels with the staged Dungeon, which keeps the old one
+void Dungeon::adoptLevel(Dungeon& staged)
+{
+	// Exchange everything that belongs to a level
+	std::swap(m_level, staged.m_level);
+	std::swap(m_monsterNum, staged.m_monsterNum);
+	m_grid.swap(staged.m_grid);
+	m_arena.swap(staged.m_arena);
+	m_availItems.swap(staged.m_availItems);
+	m_monsterList.swap(staged.m_monsterList);
+	std::swap(m_monsterStats, staged.m_monsterStats);
+	m_monsterIndex.swap(staged.m_monsterIndex);
+	m_itemIndex.swap(staged.m_itemIndex);
+	std::swap(m_openCells, staged.m_openCells);
+	std::swap(m_actorCells, staged.m_actorCells);
+	std::swap(m_itemCells, staged.m_itemCells);
+	m_distanceValid = false;
+	m_monsterVersion++;
+
+	// The switches remembered on the old level say nothing about the new one
+	m_cellChanges += CHANGELOGSIZE;
+
+	// The level's monsters and Items still point to the Dungeon that built them
+	for (size_t i = 0; i < m_monsterList.size(); i++)
+	{
+		m_monsterList[i]->setActorDungeon(this);
+	}
+	for (size_t i = 0; i < m_availItems.size(); i++)
+	{
+		m_availItems[i]->setItemDungeon(this);
+	}
 }
 
 // Mutator: Removes Item from vector of available Items
@@ -708,6 +1230,13 @@ void Dungeon::removeItem(int index)
 		counter++;
 	}
 
+	// Clear the Item's cell, and shift down the index of every Item after it
+	m_itemIndex[(*it)->getR() * m_cols + (*it)->getC()] = -1;
+	for (size_t i = index + 1; i < m_availItems.size(); i++)
+	{
+		m_itemIndex[m_availItems[i]->getR() * m_cols + m_availItems[i]->getC()]--;
+	}
+
 	m_availItems.erase(it); // Cannot delete (*it), as we shift the Item to the inventory
 }
 
@@ -727,8 +1256,49 @@ void Dungeon::removeMonster(int index)
 		counter++;
 	}
 
-	delete (*it); // Delete (*it), as the monster dies and we remove it from the Dungeon
+	// Clear the monster's cell, and shift down the index of every monster after it
+	m_monsterIndex[(*it)->row() * m_cols + (*it)->col()] = -1;
+	for (size_t i = index + 1; i < m_monsterList.size(); i++)
+	{
+		m_monsterIndex[m_monsterList[i]->row() * m_cols + m_monsterList[i]->col()]--;
+		m_monsterList[i]->setStatSlot(i - 1);
+	}
+
+	// N.B. The monster's storage is reclaimed with the rest of the level's Arena
 	it = m_monsterList.erase(it);
+
+	// Remove the monster's row from the statistics table
+	m_monsterStats.row.erase(m_monsterStats.row.begin() + index);
+	m_monsterStats.col.erase(m_monsterStats.col.begin() + index);
+	m_monsterStats.hp.erase(m_monsterStats.hp.begin() + index);
+	m_monsterStats.maxHP.erase(m_monsterStats.maxHP.begin() + index);
+	m_monsterStats.sleep.erase(m_monsterStats.sleep.begin() + index);
+	m_monsterStats.dexterity.erase(m_monsterStats.dexterity.begin() + index);
+	m_monsterStats.strength.erase(m_monsterStats.strength.begin() + index);
+	m_monsterStats.armor.erase(m_monsterStats.armor.begin() + index);
+	m_monsterStats.reach.erase(m_monsterStats.reach.begin() + index);
+	m_monsterStats.kind.erase(m_monsterStats.kind.begin() + index);
+	m_monsterVersion++;
+}
+
+// Mutator: Moves a monster's entry in the occupancy index when the monster moves
+void Dungeon::actorMoved(Actor* actor, int fromRow, int fromCol, int toRow, int toCol)
+{
+	if (!inBounds(fromRow, fromCol) || !inBounds(toRow, toCol))
+	{
+		return;
+	}
+
+	// N.B. The Player is not indexed, so for the Player there is nothing to move. Check the
+	// entry really is this Actor, as on a new level a monster may stand where the Player was
+	int index = m_monsterIndex[fromRow * m_cols + fromCol];
+	if (index == -1 || m_monsterList[index] != actor)
+	{
+		return;
+	}
+
+	m_monsterIndex[fromRow * m_cols + fromCol] = -1;
+	m_monsterIndex[toRow * m_cols + toCol] = index;
 }
 
 // Mutator: Sets the Dungeon's cell status accordingly
@@ -739,101 +1309,220 @@ void Dungeon::setStatus(int r, int c, int status)
 	// If the coordinates are valid, set the Dungeon cell status
 	if (inBounds(r, c))
 	{
-		m_grid[r][c] = status;
-	}
-}
+		// If the cell switches between traversable and blocked, the distance field is stale
+		int& cell = m_grid[r * m_cols + c];
+		bool wasOpen = (cell == EMPTY || cell == ITEM);
+		bool isOpen = (status == EMPTY || status == ITEM);
 
-// Mutator: Sets the Player attack string
-void Dungeon::setPlayerAttackString(std::string s)
-{
-	m_playerAttackResult = s;
-}
+		if (wasOpen != isOpen)
+		{
+			m_distanceValid = false;
+			m_openCells.set(r, c, isOpen);
 
-// Mutator: Sets the Player pick up string
-void Dungeon::setPlayerPickUpString(std::string s)
-{
-	m_playerPickedUpItem = s;
-}
+			// Remember the switch, for monsters following a route worked out before it
+			m_changedCells[m_cellChanges % CHANGELOGSIZE] = r * m_cols + c;
+			m_cellChanges++;
 
-// Mutator: Sets the Player Scroll string
-void Dungeon::setPlayerScrollString(std::string s)
-{
-	m_playerReadScroll = s;
-}
+			// Open cells are also where an Actor may be placed
+			if (isOpen)
+			{
+				m_actorCells.insert(r * m_cols + c);
+			}
+			else
+			{
+				m_actorCells.erase(r * m_cols + c);
+			}
+		}
 
-// Mutator: Sets the Player wield Weapon string
-void Dungeon::setPlayerWieldString(std::string s)
-{
-	m_playerWieldWeapon = s;
-}
+		// Cells without an Item (or wall) are where an Item may be placed
+		bool wasItemFree = (cell == EMPTY || cell == ACTOR);
+		bool isItemFree = (status == EMPTY || status == ACTOR);
 
-// Mutator: Sets the monster attack string
-void Dungeon::setMonsterAttackString(std::string s)
-{
-	m_monsterAttackResult += s;
-}
+		if (wasItemFree != isItemFree)
+		{
+			if (isItemFree)
+			{
+				m_itemCells.insert(r * m_cols + c);
+			}
+			else
+			{
+				m_itemCells.erase(r * m_cols + c);
+			}
+		}
 
-// Mutator: Sets empty monster attack string
-void Dungeon::setEmptyMonsterString()
-{
-	m_monsterAttackResult = "";
+		cell = status;
+	}
 }
 
-// Private Helper Function: Determines if room placement is valid
-bool Dungeon::overlap(int crow, int ccol, int dwidth, int dheight)
+// Private Helper Function: Carves a room out of the free rectangles, returning its corner
+bool Dungeon::placeRoom(int& rowcorner, int& colcorner, int& width, int& height)
 {
-	// N.B. Assumes the coordinates are the top left corner of the rectangle
-	bool isOverlap = false;
+	// N.B. A room needs its own cells plus one wall row below and one wall column to its
+	// right, so that no two rooms touch; the free rectangles already leave room above and
+	// to the left
 
-	// If our room has gone out of bounds, return true
-	if (crow + dheight >= DUNGEONROWS - 1 || ccol + dwidth >= DUNGEONCOLS - 1)
+	// Find the free rectangles that hold the room at its chosen size
+	m_roomCandidates.clear();
+	for (size_t i = 0; i < m_freeRects.size(); i++)
 	{
-		return(true); 
+		if (m_freeRects[i].height > height && m_freeRects[i].width > width)
+		{
+			m_roomCandidates.push_back(i);
+		}
 	}
 
-	// Loop through the Dungeon's cells, checkingif any are invalid
-	for (int i = crow; i < crow + dheight; i++)
+	// Otherwise, shrink the room to fit a free rectangle that holds the smallest room
+	if (m_roomCandidates.empty())
 	{
-		for (int j = ccol; j < ccol + dwidth; j++)
+		for (size_t i = 0; i < m_freeRects.size(); i++)
 		{
-			if (i == crow)
+			if (m_freeRects[i].height > MINROOMHEIGHT && m_freeRects[i].width > MINROOMWIDTH)
 			{
-				if (getStatus(i - 1, j) == EMPTY)
-				{
-					return(true); // We have infringed upon another room
-				}
+				m_roomCandidates.push_back(i);
 			}
+		}
+	}
 
-			if (i == crow + dheight - 1)
-			{
-				if (getStatus(i + 1, j) == EMPTY)
-				{
-					return(true); // We have infringed upon another room
-				}
-			}
+	if (m_roomCandidates.empty())
+	{
+		return(false); // There is no space left for another room
+	}
 
-			if (j == ccol + dwidth - 1)
-			{
-				if (getStatus(i, j + 1) == EMPTY)
-				{
-					return(true); // We have infringed upon another room
-				}
-			}
+	// Place the room at random within a randomly chosen free rectangle
+	int chosen = m_roomCandidates[m_random.randInt(0, m_roomCandidates.size() - 1)];
+	LayoutRect space = m_freeRects[chosen];
+
+	height = std::min(height, space.height - 1);
+	width = std::min(width, space.width - 1);
+	rowcorner = space.row + m_random.randInt(0, space.height - height - 1);
+	colcorner = space.col + m_random.randInt(0, space.width - width - 1);
+
+	// Split the rest of the rectangle into the bands above, below, left and right of the room
+	int bottom = rowcorner + height + 1; // The row after the room's wall row
+	int right = colcorner + width + 1; // The column after the room's wall column
+	LayoutRect pieces[4] =
+	{
+		{ space.row, space.col, rowcorner - space.row, space.width },
+		{ bottom, space.col, space.row + space.height - bottom, space.width },
+		{ rowcorner, space.col, bottom - rowcorner, colcorner - space.col },
+		{ rowcorner, right, bottom - rowcorner, space.col + space.width - right }
+	};
+
+	m_freeRects[chosen] = m_freeRects.back();
+	m_freeRects.pop_back();
+
+	// Keep only the pieces that could still hold a room
+	for (int p = 0; p < 4; p++)
+	{
+		if (pieces[p].height > MINROOMHEIGHT && pieces[p].width > MINROOMWIDTH)
+		{
+			m_freeRects.push_back(pieces[p]);
+		}
+	}
+
+	return(true);
+}
+
+// Private Helper Function: Builds the field of path distances to the Player
+void Dungeon::buildDistanceField() const
+{
+	// A single breadth first search runs outward from the Player across traversable
+	// cells (i.e. EMPTY or ITEM). A monster one step beyond the smell distance can never
+	// smell the Player, so the search stops expanding at one less than that distance.
+	// Each step spreads the whole frontier at once on the Bitboards, and only the cells
+	// that newly joined it are written into the field.
+
+	// Size the field on first use; unmarked cells hold -1
+	if (m_playerDistance.empty())
+	{
+		m_playerDistance.assign(m_rows * m_cols, -1);
+	}
 
-			if (j == ccol)
+	// Only the cells marked by the last build need to be cleared
+	for (size_t i = 0; i < m_distanceQueue.size(); i++)
+	{
+		m_playerDistance[m_distanceQueue[i]] = -1;
+	}
+	m_distanceQueue.clear();
+
+	m_distanceRow = m_player->row();
+	m_distanceCol = m_player->col();
+	m_distanceValid = true;
+
+	// Start the search at the Player's cell, at distance zero
+	resetFrontier();
+	m_frontier.set(m_distanceRow, m_distanceCol, true);
+	m_visited.set(m_distanceRow, m_distanceCol, true);
+	m_playerDistance[m_distanceRow * m_cols + m_distanceCol] = 0;
+	m_distanceQueue.push_back(m_distanceRow * m_cols + m_distanceCol);
+	int frontierFirst = m_distanceRow; // The first row the frontier occupies
+	int frontierLast = m_distanceRow; // The last row the frontier occupies
+
+	for (int dist = 1; dist < m_smellDistance; dist++)
+	{
+		// The frontier can only spread one row further in each direction
+		int firstRow = std::max(0, frontierFirst - 1);
+		int lastRow = std::min(m_rows - 1, frontierLast + 1);
+
+		if (!m_nextFrontier.expand(m_frontier, m_openCells, m_visited, firstRow, lastRow))
+		{
+			break; // Every reachable cell has been marked
+		}
+
+		// Mark each cell that newly joined the frontier with its distance
+		for (int r = firstRow; r <= lastRow; r++)
+		{
+			const std::uint64_t* words = m_nextFrontier.rowWords(r);
+
+			for (int w = 0; w < m_nextFrontier.getWords(); w++)
 			{
-				if (getStatus(i, j - 1) == EMPTY)
+				std::uint64_t bits = words[w];
+
+				while (bits != 0)
 				{
-					return(true); // We have infringed upon another room
+					int cell = r * m_cols + w * 64 + Bitboard::lowestBit(bits);
+					m_playerDistance[cell] = dist;
+					m_distanceQueue.push_back(cell);
+					bits &= bits - 1; // Clear the lowest set bit
 				}
 			}
+		}
 
-			if (getStatus(i, j) == EMPTY)
-			{
-				return(true); // We have infringed onto an existing room!
-			}
+		advanceFrontier(frontierFirst, frontierLast, firstRow, lastRow);
+		frontierFirst = firstRow;
+		frontierLast = lastRow;
+	}
+
+	// Keep count of the work done, for benchmarking
+	m_fieldBuilds++;
+	m_fieldCells += m_distanceQueue.size();
+}
+
+// Private Helper Function: Clears the search Bitboards
+void Dungeon::resetFrontier() const
+{
+	m_frontier.clearRows(0, m_rows - 1);
+	m_nextFrontier.clearRows(0, m_rows - 1);
+	m_visited.clearRows(0, m_rows - 1);
+}
+
+// Private Helper Function: Makes the next frontier current and marks it as visited
+void Dungeon::advanceFrontier(int oldFirst, int oldLast, int firstRow, int lastRow) const
+{
+	// N.B. oldFirst to oldLast are the rows of the current frontier, and firstRow to
+	// lastRow are the rows the next frontier reached in the last expand()
+	for (int r = firstRow; r <= lastRow; r++)
+	{
+		const std::uint64_t* next = m_nextFrontier.rowWords(r);
+		std::uint64_t* seen = m_visited.rowWords(r);
+
+		for (int w = 0; w < m_visited.getWords(); w++)
+		{
+			seen[w] |= next[w];
 		}
 	}
 
-	return(isOverlap);
+	// Swap the frontiers, then clear the old frontier's rows for the next expand()
+	std::swap(m_frontier, m_nextFrontier);
+	m_nextFrontier.clearRows(oldFirst, oldLast);
 }
\ No newline at end of file
@@ -3,6 +3,13 @@
 #ifndef DUNGEON_INCLUDED
 #define DUNGEON_INCLUDED
 
+#include "Arena.h"
+#include "Bitboard.h"
+#include "CellSet.h"
+#include "MessageLog.h"
+#include "Random.h"
+#include <cstdint>
+#include <future>
 #include <string>
 #include <vector>
 
@@ -17,16 +24,79 @@
    not used later), this is deliberately done in order to see the flow of events in the code.
  - The Dungeon holds important information to the Game, such as a record of available 
    Items and the level's Actors. Vector containers are used to store this information.
- - For Dungeon layout, a private helper function is used to ensure that rooms do not overlap
-   upon each other (i.e. they are distinct). Implementation of this is in the .cpp file.
- - For Game output, the Dungeon contains the appropriate strings, and command of all Game
-   output is handled by the display() function.
+ - Each cell also records the index of the monster and of the Item on it, so finding what
+   is at a position takes constant time. The index is kept up to date as monsters move,
+   die and are added, and as Items are dropped and picked up.
+ - The Dungeon also owns the monsters' statistics, stored as one array per field (the
+   MonsterStats table) in the same order as the vector of monsters. Monster turns sweep
+   these arrays instead of visiting each monster object in turn.
+ - The monsters, their Weapons and the floor Items of a level are created in the Dungeon's
+   Arena rather than with new, and are all destroyed together when the level ends. The
+   Player and its inventory live on the heap, as they carry over to the next level.
+ - The Dungeon also owns the Game's random number context. Actors and Items reach it
+   through their Dungeon pointer, so a seeded Dungeon plays out the same way every time.
+ - The Dungeon's dimensions are chosen at construction (18 x 70 by default), and every grid
+   walking routine sizes itself from m_rows and m_cols, so much larger maps are supported.
+ - For Dungeon layout, rooms are carved out of a list of free rectangles (guillotine
+   packing), so that they never overlap upon each other (i.e. they are distinct). Each
+   room takes one free rectangle that can hold it plus a wall between it and its
+   neighbours, and what is left of that rectangle is split into at most four smaller ones.
+   No cell is scanned and nothing is retried, so a level is generated in bounded time; if
+   no free rectangle can hold even the smallest room, the level simply has fewer rooms.
+ - For Game output, the Dungeon keeps the Game's MessageLog, and command of all Game
+   output is handled by the display() function, which draws into a frame buffer that the
+   Game's Renderer then sends to the terminal. Messages are posted as records and only
+   turned into text there.
+ - The Dungeon keeps one shared field of path distances to the Player, which every chasing
+   monster reads from. It is built lazily on the first query and rebuilt only after a cell
+   changes between traversable and blocked, or after the Player moves.
+ - The Dungeon also counts the cells that change between traversable and blocked, and
+   remembers the most recent of them, so that a monster following a route it worked out
+   earlier can tell whether anything that could change its route has happened since.
+ - Traversable cells are also mirrored into a Bitboard, so that path searches expand a
+   whole frontier per step with word operations instead of visiting cells one at a time.
+ - Every level after the first is generated from a random sequence of its own, seeded
+   from the Game's seed and the level number, and built as a separate staging Dungeon.
+   newLevel() then takes over the staging Dungeon's layout, Items and monsters, leaving
+   it the old level to destroy. As nothing in a level depends on how the previous one was
+   played, the staging Dungeon may be built on a worker thread while the current level is
+   played (see setPregenerate()), and the seeded outcome is the same either way.
+ - Random placement (monsters, Items, the Player, teleportation) draws from two CellSets,
+   one of the cells an Actor may be placed on and one of the cells an Item may be placed
+   on, kept up to date by setStatus(). A pick takes constant time however full the map is,
+   and reports failure instead of retrying forever when no cell is left.
+ - A Dungeon can gather its whole state into a SaveData, and can be built from a checked
+   SaveFile instead of being generated. The Actors and Items are recreated in their saved
+   order, and the placement sets, Message history and random state are put back exactly,
+   so a loaded Game plays on just as the saved one would have.
 */
 
-// Dungeon Dimensional Constants
+enum class ActorKind; // Indicates to compiler that ActorKind is an enum
+
+// Monster statistics, one array per field, with row i belonging to the Dungeon's i-th monster
+struct MonsterStats
+{
+    std::vector<int> row; // The monsters' row coordinates
+    std::vector<int> col; // The monsters' column coordinates
+    std::vector<int> hp; // The monsters' hit points
+    std::vector<int> maxHP; // The monsters' maximum hit points
+    std::vector<int> sleep; // The monsters' sleep times
+    std::vector<int> dexterity; // The monsters' dexterity points
+    std::vector<int> strength; // The monsters' strength points
+    std::vector<int> armor; // The monsters' armor points
+    std::vector<int> reach; // How far away each monster notices the Player
+    std::vector<ActorKind> kind; // The monsters' kinds
+
+    void clear(); // Empties every field, keeping the storage
+};
+
+// Dungeon Dimensional Constants (the standard, and minimum, Dungeon size)
 const int DUNGEONROWS = 18;
 const int DUNGEONCOLS = 70;
 
+// The deepest Dungeon level, which holds the golden idol instead of a stairway
+const int IDOLLEVEL = 4;
+
 // Dungeon Cell Status Constants
 const int EMPTY = 0; // Cell is empty
 const int ACTOR = 1; // Cell contains Actor only
@@ -34,14 +104,27 @@ const int ITEM = 2; // Cell contains Item only
 const int ACTORITEM = 3; // Cell contains both Actor and Item
 const int WALLS = 9; // Cell is a wall
 
+// A rectangle of cells, used to lay out the Dungeon's rooms
+struct LayoutRect
+{
+    int row; // The rectangle's top row
+    int col; // The rectangle's left column
+    int height; // The rectangle's number of rows
+    int width; // The rectangle's number of columns
+};
+
 class Actor; // Indicates to compiler that Actor is a class
 class Item; // Indicates to compiler that Item is a class
+class SaveFile; // Indicates to compiler that SaveFile is a class
+struct SaveData; // Indicates to compiler that SaveData is a struct
+struct SaveItem; // Indicates to compiler that SaveItem is a struct
 
 class Dungeon
 {
 public:
     // Constructors and Destructors
-    Dungeon(int level, int smellDistance);
+    Dungeon(int level, int smellDistance, std::uint64_t seed, int rows, int cols);
+    Dungeon(const SaveFile& save); // Restores a saved Dungeon, Player included
     ~Dungeon();
 
     // Accessor Functions
@@ -52,53 +135,103 @@ public:
     int actorAtPos(int r, int c) const; // Retrieve index of Actor at the position
     int itemAtPos(int r, int c) const; // Retrieve index of Item at the position
     bool inBounds(int r, int c) const; // Determines if given coordinates are valid
-    void display() const; // Displays the Dungeon
+    int playerDistance(int r, int c) const; // Retrieve the cell's path distance to the Player
+    bool isNextLevelReady() const; // Retrieve whether the next level is built and waiting
+
+    // Retrieve the path distance between two cells within a limit, or -1 if unreachable
+    int pathDistance(int sr, int sc, int er, int ec, int limit) const;
+    long long getFieldBuilds() const; // Retrieve the number of distance field builds
+    long long getFieldCells() const; // Retrieve the number of cells those builds marked
+    unsigned getMonsterVersion() const; // Retrieve a count of changes to the monster table
+    long long getCellChanges() const; // Retrieve how many cells switched open or blocked
+    int getChangedCell(long long change) const; // Retrieve the cell of a recent switch
+    void display(std::string& frame) const; // Draws the Dungeon into a frame
+    void save(SaveData& data) const; // Gathers the Dungeon's state for a save file
 
     Actor* player() const; // Retrieves the Dungeon's Player pointer
-    std::vector<Item*> getAvailItems() const; // Retrieves the vector of available items
-    std::vector<Actor*> getMonsters() const; // Retrieves the vector of monsters
+    Random& rng(); // Retrieves the Dungeon's random number context
+    Arena& arena(); // Retrieves the storage for the level's monsters and Items
+    MessageLog& messages(); // Retrieves the log of what happened in the Game
+    const std::vector<Item*>& getAvailItems() const; // Retrieves the available items
+    const std::vector<Actor*>& getMonsters() const; // Retrieves the monsters
+    const MonsterStats& monsterStats() const; // Retrieves the monsters' statistics table
+    MonsterStats& monsterStats(); // Retrieves the monsters' statistics table to modify
 
     // Mutator Functions
     bool addPlayer(int r, int c); // Adds Player to the Dungeon
+    bool addMonster(Actor* monster); // Adds a monster (created in the Arena) to the Dungeon
     bool addrandItem(int r, int c, bool sflag, bool gflag); // Adds Item to the Dungeon
 
     // Adds the monster drop reward
     void addDrop(int r, int c, std::string name, std::string weaponClass);
     void generateLayout(int level); // Generates a unique Dungeon layout
     void newLevel(int level); // Generates a new Dungeon
+    void setPregenerate(bool enabled); // Builds each next level in the background
     void removeItem(int index); // Removes Item from Dungeon
     void removeMonster(int index); // Removes monster from Dungeon
+    void actorMoved(Actor* actor, int fromRow, int fromCol, int toRow, int toCol); // Reindex
     void setStatus(int r, int c, int status); // Sets the Dungeon's cell status
-   
-    // Output String Functions
-    void setPlayerAttackString(std::string s); // Sets Player's attack result
-    void setPlayerPickUpString(std::string s); // Sets Player's pick up Item result
-    void setPlayerScrollString(std::string s); //Sets Player's read Scroll result
-    void setPlayerWieldString(std::string s); // Sets Player's wield Weapon result
-    void setMonsterAttackString(std::string s); // Sets monster's attack result
-    void setEmptyMonsterString(); // Sets monster's attack result to the empty string
+    bool randomActorCell(int& r, int& c); // Picks a random cell an Actor may be placed on
+    bool randomItemCell(int& r, int& c); // Picks a random cell an Item may be placed on
 
 private:
-    // Private Layout Helper Function
-    bool overlap(int crow, int ccol, int dwidth, int dheight);
+    // Private Construction Helper Functions
+    void initialize(int level, int smellDistance, int rows, int cols); // Sizes the tables
+    Item* restoreItem(const SaveItem& record, Actor* owner); // Recreates a saved Item
+
+    // Private Layout Helper Functions
+    bool placeRoom(int& rowcorner, int& colcorner, int& width, int& height);
+    std::uint64_t levelSeed(int level) const; // The seed the level is generated from
+    void startPregeneration(int level); // Starts building the level on a worker thread
+    void adoptLevel(Dungeon& staged); // Takes over the staged Dungeon's level
+
+    // Private Distance Field Helper Functions
+    void buildDistanceField() const;
+    void resetFrontier() const;
+    void advanceFrontier(int oldFirst, int oldLast, int firstRow, int lastRow) const;
 
     // Dungeon's data members
     int m_rows; // The Dungeon's row dimension
     int m_cols; // The Dungeon's column dimension
-    int m_grid[DUNGEONROWS][DUNGEONCOLS]; // The Dungeon's information grid
+    std::vector<int> m_grid; // The Dungeon's information grid, stored row by row
     int m_level; // The Dungeon's level
     int m_monsterNum; // The Dungeon's number of monsters
     int m_smellDistance; // The Dungeon's Goblin smell distance
+    Random m_random; // The Dungeon's random number context
 
+    Arena m_arena; // The Dungeon's storage for the current level's monsters and Items
     Actor* m_player; // The Dungeon's Player
     std::vector<Item*> m_availItems; // The Dungeon's vector of available Items
     std::vector<Actor*> m_monsterList; // The Dungeon's vector of monsters
-
-    std::string m_playerAttackResult; // The Dungeon's Player attack string
-    std::string m_playerPickedUpItem; // The Dungeon's Player pick up string
-    std::string m_playerReadScroll; // The Dungeon's Player read Scroll string
-    std::string m_playerWieldWeapon; // The Dungeon's Player wield Weapon string
-    std::string m_monsterAttackResult; // The Dungeon's monster attack string
+    MonsterStats m_monsterStats; // The Dungeon's monster statistics, in step with the list
+    unsigned m_monsterVersion; // Bumped whenever a monster is added or removed, or on a new level
+    std::vector<int> m_monsterIndex; // The Dungeon's monster index per cell, or -1
+    std::vector<int> m_itemIndex; // The Dungeon's Item index per cell, or -1
+    std::vector<LayoutRect> m_freeRects; // The space still free for rooms, during layout
+    std::vector<int> m_roomCandidates; // The free rectangles that can hold the next room
+
+    mutable std::vector<int> m_playerDistance; // The Dungeon's distance to Player per cell
+    mutable std::vector<int> m_distanceQueue; // The Dungeon's cells marked in the field
+    mutable bool m_distanceValid; // Whether the distance field is up to date
+    mutable int m_distanceRow; // The Player row the distance field was built from
+    mutable int m_distanceCol; // The Player column the distance field was built from
+    mutable long long m_fieldBuilds; // The number of times the distance field was built
+    mutable long long m_fieldCells; // The number of cells marked across all builds
+    long long m_cellChanges; // The number of cells that have switched open or blocked
+    std::vector<int> m_changedCells; // The cells of the most recent switches, in a ring
+
+    Bitboard m_openCells; // The Dungeon's traversable cells (i.e. EMPTY or ITEM)
+    CellSet m_actorCells; // The cells an Actor may be placed on (i.e. EMPTY or ITEM)
+    CellSet m_itemCells; // The cells an Item may be placed on (i.e. EMPTY or ACTOR)
+    mutable Bitboard m_frontier; // The search's current frontier
+    mutable Bitboard m_nextFrontier; // The search's next frontier
+    mutable Bitboard m_visited; // The search's visited cells
+
+    MessageLog m_messages; // The Dungeon's log of Player and monster Messages
+
+    bool m_pregenerate; // Whether each next level is built in the background
+    int m_stagedLevel; // The level being built in the background, if any
+    std::future<Dungeon*> m_staged; // The level being built in the background
 };
 
 #endif // DUNGEON_INCLUDED
\ No newline at end of file
@@ -3,27 +3,51 @@
 #include "Actor.h"
 #include "Dungeon.h"
 #include "Game.h"
+#include "Instrument.h"
 #include "Item.h"
+#include "Replay.h"
+#include "SaveFile.h"
 #include "utilities.h"
+#include <cctype>
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
 
-// Game constructor with parameter Goblin smell distance
+// The number of Messages shown by the Message history
+const int HISTORYLINES = 20;
+
+// The file the save and load keys use
+const char SAVEFILE[] = "minirogue.sav";
+
+// Game constructor with parameter Goblin smell distance (seeded from the random device)
 Game::Game(int goblinSmellDistance)
+    : Game(goblinSmellDistance, Random().getSeed())
+{
+}
+
+// Game constructor with parameters Goblin smell distance and random seed (standard size)
+Game::Game(int goblinSmellDistance, std::uint64_t seed)
+    : Game(goblinSmellDistance, seed, DUNGEONROWS, DUNGEONCOLS)
+{
+}
+
+// Game constructor with parameters Goblin smell distance, random seed and Dungeon dimensions
+Game::Game(int goblinSmellDistance, std::uint64_t seed, int rows, int cols)
+    : m_renderer(std::cout)
 {
     // Create the dungeon
-    m_dungeon = new Dungeon(0, goblinSmellDistance);
+    m_dungeon = new Dungeon(0, goblinSmellDistance, seed, rows, cols);
+    m_render = true; // By default, the Game is drawn to the terminal
+    m_turns = 0; // No turns have been taken yet
+    m_cheated = false; // The Player has not cheated yet
+    m_saveFile = SAVEFILE; // The save and load keys use the usual file
+    m_recorder = new ReplayRecorder; // Nothing is recorded until recording starts
 
     // Retrieve valid coordinates to add the player
-    int initrow = randInt(1, m_dungeon->getRow() - 2);
-    int initcol = randInt(1, m_dungeon->getCol() - 2);
-    
-    while (m_dungeon->getStatus(initrow, initcol) != EMPTY &&
-        m_dungeon->getStatus(initrow, initcol) != ITEM)
-    {
-        // If the coordinates are invalid, keep resetting until valid
-        initrow = randInt(1, m_dungeon->getRow() - 2);
-        initcol = randInt(1, m_dungeon->getCol() - 2);
-    }
+    // N.B. The Dungeon always leaves a cell free for the Player
+    int initrow;
+    int initcol;
+    m_dungeon->randomActorCell(initrow, initcol);
 
     m_dungeon->addPlayer(initrow, initcol);
 
@@ -42,16 +66,105 @@ Game::Game(int goblinSmellDistance)
 Game::~Game()
 {
     delete m_dungeon; // Delete the Game's Dungeon
+    delete m_recorder; // Delete the Game's recorder, closing any unfinished log
+}
+
+// Accessor: returns the seed the Game was started from
+std::uint64_t Game::getSeed() const
+{
+    return(m_dungeon->rng().getSeed());
+}
+
+// Accessor: saves the Game to the file, returning whether it was written
+bool Game::save(const std::string& path) const
+{
+    SaveData data;
+    gather(data);
+
+    return(SaveFile::write(path, data));
+}
+
+// Accessor: returns a hash of the Game's whole state (that is, of its save file)
+std::uint64_t Game::stateHash() const
+{
+    SaveData data;
+    gather(data);
+
+    std::vector<char> bytes;
+    SaveFile::serialize(data, bytes);
+
+    return(SaveFile::hash(bytes.data(), bytes.size()));
+}
+
+// Mutator: replaces the Game with the one saved in the file, returning whether it loaded
+bool Game::load(const std::string& path)
+{
+    // A file that cannot be read, or is damaged, leaves the current Game untouched
+    SaveFile file;
+
+    if (!file.open(path))
+    {
+        return(false);
+    }
+
+    load(file);
+
+    return(true);
+}
+
+// Mutator: replaces the Game with the one in the open save file
+void Game::load(const SaveFile& file)
+{
+    Dungeon* dungeon = new Dungeon(file);
+    delete m_dungeon;
+    m_dungeon = dungeon;
+    m_turns = file.header().turns;
+    m_cheated = (file.header().cheated != 0);
+    m_active.invalidate(); // The new Dungeon's monsters have to be looked at afresh
+
+    // The replay log starts over from the loaded Game, so it never needs the save file
+    if (m_recorder->isRecording())
+    {
+        m_recorder->restart(file.data(), file.size());
+    }
+}
+
+// Mutator: sets the file the save and load keys use; with no file, the keys do nothing
+void Game::setSaveFile(const std::string& path)
+{
+    m_saveFile = path;
+}
+
+// Mutator: starts recording every key read to a replay log, from the Game as it is now
+bool Game::startRecording(const std::string& path)
+{
+    SaveData data;
+    gather(data);
+
+    std::vector<char> snapshot;
+    SaveFile::serialize(data, snapshot);
+
+    return(m_recorder->start(path, snapshot.data(), snapshot.size()));
+}
+
+// Mutator: finishes the replay log, so that a replay of it can be checked
+void Game::stopRecording()
+{
+    if (m_recorder->isRecording())
+    {
+        m_recorder->finish(stateHash());
+    }
 }
 
 // Mutator: the Player takes their turn
 void Game::playerTurn(char ckey, bool& cheat)
 {
-    // Reset Player result strings at the beginning of each turn
-    m_dungeon->setPlayerAttackString("");
-    m_dungeon->setPlayerPickUpString("");
-    m_dungeon->setPlayerScrollString("");
-    m_dungeon->setPlayerWieldString("");
+    INSTRUMENT_PHASE(InstrumentPhase::PlayerTurn);
+
+    // Clear the Player's Messages from the screen at the beginning of each turn
+    m_dungeon->messages().startPlayerTurn();
+
+    m_turns++; // Count the Player's turn
 
     // Determine whether the Player will regain 1 hit point before its turn
     int currentHP = m_dungeon->player()->getHP();
@@ -60,18 +173,18 @@ void Game::playerTurn(char ckey, bool& cheat)
     if (currentHP < maxHP)
     {
         // The Player has a 1/10 chance of regaining 1 hit point before its turn
-        bool regainHealth = trueWithProbability(1.0 / 10.0);
+        bool regainHealth = m_dungeon->rng().trueWithProbability(1.0 / 10.0);
 
         if (regainHealth)
         {
-            m_dungeon->player()->changeStats(1, "HP");
+            m_dungeon->player()->changeStats(1, StatCategory::HP);
         }
     }
 
     // If the Player is asleep, decrement its sleep time and return immediately
     if (m_dungeon->player()->getSleep() > 0)
     {
-        m_dungeon->player()->changeStats(-1, "Sleep");
+        m_dungeon->player()->changeStats(-1, StatCategory::Sleep);
         return;
     }
     
@@ -105,14 +218,14 @@ void Game::playerTurn(char ckey, bool& cheat)
             // Increase the Player's hit points and maximum hit points to 50
             if (deltaMaxHP > 0)
             {
-                m_dungeon->player()->changeStats(deltaMaxHP, "Max HP");
-                m_dungeon->player()->changeStats(deltaHP, "HP");
+                m_dungeon->player()->changeStats(deltaMaxHP, StatCategory::MaxHP);
+                m_dungeon->player()->changeStats(deltaHP, StatCategory::HP);
             }
 
             // Increase the Player's strength up to 9, if possible
             if (modifier > 0)
             {
-                m_dungeon->player()->changeStats(modifier, "Strength");
+                m_dungeon->player()->changeStats(modifier, StatCategory::Strength);
             }
             break;
         case ARROW_LEFT: // Move left
@@ -128,16 +241,25 @@ void Game::playerTurn(char ckey, bool& cheat)
             dcol++;
             break;
         case 'i': // Display the Player's inventory
-            m_dungeon->player()->dispInventory();
+            if (m_render)
+            {
+                drawInventory();
+            }
             break;
         case 'g': // Player attempts to pick up Item
             m_dungeon->player()->pickUp(playerrow, playercol, true);
             break;
         case 'r': // Player attempts to read Scroll
-            m_dungeon->player()->dispInventory();
+            if (m_render)
+            {
+                drawInventory();
+            }
             break;
         case 'w': // Player attempts to wield Weapon
-            m_dungeon->player()->dispInventory();
+            if (m_render)
+            {
+                drawInventory();
+            }
             break;
         case '>': // Player attempts to descend stairway
             m_dungeon->player()->pickUp(playerrow, playercol, false);
@@ -169,111 +291,300 @@ void Game::monsterTurn()
         return;
     }
     
-    // Obtain the Dungeon's vector of all monsters
-    std::vector<Actor*> ai = m_dungeon->getMonsters();
+    // Obtain the Dungeon's vector of all monsters, and the table of their statistics
+    // N.B. No monster is added or removed during the monsters' turn, so no copy is needed
+    const std::vector<Actor*>& ai = m_dungeon->getMonsters();
+    MonsterStats& stats = m_dungeon->monsterStats();
+    int count = static_cast<int>(ai.size());
 
-    // Reset the monsters' result string on each overall turn
-    m_dungeon->setEmptyMonsterString();
+    // Clear the monsters' Messages from the screen on each overall turn
+    m_dungeon->messages().startMonsterTurn();
 
-    // Loop through the vector of monsters and take their turn appropriately
-    for (size_t i = 0; i < ai.size(); i++)
+    // If the Player is dead, return immediately as the Game is automatically over
+    if (m_dungeon->player()->getHP() <= 0)
     {
-        // Obtain the monster's current coordinates
-        int monsterRow = ai[i]->row();
-        int monsterCol = ai[i]->col();
+        return;
+    }
+
+    m_acting.resize(count);
+    unsigned char* acting = m_acting.data();
+    int* sleep = stats.sleep.data();
+
+    // Sleeping monsters count down their sleep time instead of acting, wherever they are
+    for (int i = 0; i < count; i++)
+    {
+        acting[i] = (sleep[i] <= 0);
+        sleep[i] -= (sleep[i] > 0);
+    }
+
+    // Only the monsters the Player could be within reach of are visited (see ActivitySet)
+    m_active.update(stats, m_dungeon->player()->row(), m_dungeon->player()->col(),
+        m_dungeon->getMonsterVersion());
+    const std::vector<int>& visits = m_active.getVisits();
+
+    // Loop through the visits in table order, as their rolls share the Game's random sequence
+    for (size_t v = 0; v < visits.size(); v++)
+    {
+        int i = visits[v];
 
         // If the Player is dead, return immediately as the Game is automatically over
         if (m_dungeon->player()->getHP() <= 0)
         {
             break;
         }
-        
+
         // Check whether each Dragon will regenerate 1 hit point
-        if (ai[i]->getActorName() == "Dragon")
+        if (stats.kind[i] == ActorKind::Dragon)
         {
-            int currentHP = ai[i]->getHP();
-            int maxHP = ai[i]->getMaxHP();
-
             // Dragons have a 1/10 chance of generating 1 hit point up to their maximum
-            bool regainHealth = trueWithProbability(1.0 / 10.0);
+            bool regainHealth = m_dungeon->rng().trueWithProbability(1.0 / 10.0);
 
-            if (currentHP < maxHP && regainHealth)
+            if (stats.hp[i] < stats.maxHP[i] && regainHealth)
             {
-                ai[i]->changeStats(1, "HP");
+                ai[i]->changeStats(1, StatCategory::HP);
             }
         }
 
-        // Check whether each monster is asleep, in which case it does nothing
-        if (ai[i]->getSleep() > 0)
+        // Awake monsters within reach of the Player take their move
+        if (acting[i] && m_active.inReach(i))
         {
-            ai[i]->changeStats(-1, "Sleep");
-        }
-        else
-        {
-            ai[i]->move(monsterRow, monsterCol);
+            INSTRUMENT_PHASE(Instrument::monsterPhase(stats.kind[i]));
+            ai[i]->move(stats.row[i], stats.col[i]);
         }
     }
 }
 
-// Mutator: play the actual Game
+// Mutator: play the actual Game at the terminal
 void Game::play()
 {
+    // Build each next level while the current one is played, so descending never stalls
+    // N.B. Levels come out the same either way, so headless Games keep to one thread
+    m_dungeon->setPregenerate(true);
+
+    // Record the Game as it is played, so that it can be replayed exactly (see Replay)
+    startRecording(REPLAYFILE);
+    run(getCharacter, true);
+    stopRecording();
+
+#ifdef MINIROGUE_INSTRUMENT
+    Instrument::report(std::cerr); // Leave the allocation summary behind on exit
+#endif
+}
+
+// Mutator: play the Game headlessly from a string of commands
+GameResult Game::runHeadless(const std::string& commands)
+{
+    size_t next = 0; // Index of the next command to issue
+
+    return(run([&commands, &next]() -> char
+    {
+        // Skip whitespace, so commands may be spread across lines
+        while (next < commands.size() && std::isspace(static_cast<unsigned char>(commands[next])))
+        {
+            next++;
+        }
+
+        // Once the commands run out, the Player quits
+        if (next >= commands.size())
+        {
+            return('q');
+        }
+
+        return(commands[next++]);
+    }, false));
+}
+
+// Mutator: play the Game headlessly from a stream (e.g. a file) of commands
+GameResult Game::runHeadless(std::istream& commands)
+{
+    return(run([&commands]() -> char
+    {
+        char key;
+
+        // Skip whitespace; once the stream runs out, the Player quits
+        if (!(commands >> key))
+        {
+            return('q');
+        }
+
+        return(key);
+    }, false));
+}
+
+// Mutator: play the Game headlessly, asking the callback for each command
+GameResult Game::runHeadless(std::function<char()> nextKey)
+{
+    return(run(nextKey, false));
+}
+
+// Mutator: play the Game, reading keys from the given source
+GameResult Game::run(std::function<char()> nextKey, bool render)
+{
+    m_render = render; // Determines whether the Game is drawn to the screen
+
+    // Record every key read, when a replay log is being written
+    if (m_recorder->isRecording())
+    {
+        std::function<char()> source = nextKey;
+
+        nextKey = [this, source]() -> char
+        {
+            char key = source();
+
+#ifdef MINIROGUE_INSTRUMENT
+            // The debug key takes no turn here, but would take one in a build without it
+            if (key == INSTRUMENT_KEY)
+            {
+                return(key);
+            }
+#endif
+
+            m_recorder->record(key);
+
+            // A Game at the terminal may end any moment, so its keys go straight to the file
+            if (m_render)
+            {
+                m_recorder->flush();
+            }
+
+            return(key);
+        };
+    }
+
     // Display the initial Game state
-    m_dungeon->display();
-    char key = getCharacter(); // Obtain the very first keyboard input
+    if (m_render)
+    {
+        drawDungeon("");
+    }
+    char key = nextKey(); // Obtain the very first keyboard input
     bool flag = true; // Keeps track of whether we should enter the inventory
-    bool cheatFlag = false; // Keeps track of whether we have already cheated
 
     // Game loop
     while (key != 'q')
     {
-        clearScreen(); // Clear the screen at the beginning of each turn
+#ifdef MINIROGUE_INSTRUMENT
+        // The debug key shows the allocation summary below the Dungeon, without a turn
+        if (key == INSTRUMENT_KEY)
+        {
+            if (m_render)
+            {
+                std::ostringstream summary;
+                Instrument::report(summary);
+                drawDungeon(summary.str());
+            }
+
+            key = nextKey(); // Retrieve the next turn keyboard input
+            continue;
+        }
+#endif
+
+        // Save or load the Game, without taking a turn
+        if (key == SAVE_KEY || key == LOAD_KEY)
+        {
+            std::string footer;
+
+            if (m_saveFile.empty())
+            {
+                footer = "Saving is turned off.\n";
+            }
+            else if (key == SAVE_KEY)
+            {
+                footer = save(m_saveFile) ? "Game saved.\n" : "The Game could not be saved.\n";
+            }
+            else if (load(m_saveFile))
+            {
+                footer = "Game loaded.\n";
+
+                // The loaded Dungeon builds its next level in the background too, when drawn
+                if (m_render)
+                {
+                    m_dungeon->setPregenerate(true);
+                }
+            }
+            else
+            {
+                footer = "There is no saved Game to load.\n";
+            }
+
+            if (m_render)
+            {
+                drawDungeon(footer);
+            }
+
+            key = nextKey(); // Retrieve the next turn keyboard input
+            continue;
+        }
+
+        // Show the Message history until the next key, without taking a turn
+        if (key == 'm')
+        {
+            if (m_render)
+            {
+                drawHistory();
+            }
+
+            key = nextKey(); // Any key returns to the Dungeon
+
+            if (m_render)
+            {
+                drawDungeon("");
+            }
+
+            key = nextKey(); // Retrieve the next turn keyboard input
+            continue;
+        }
 
         if (key == 'i' && flag)
         {
-            playerTurn(key, cheatFlag); // Display the Player's inventory
+            playerTurn(key, m_cheated); // Display the Player's inventory
             flag = false; // Set the inventory flag to be false
 
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
             monsterTurn(); // Let monsters all take their turn
 
             // Display the new Game state
-            clearScreen();
-            m_dungeon->display();
+            if (m_render)
+            {
+                drawDungeon("");
+            }
             flag = true; // After one turn, we can reenter the inventory if we wish
 
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
         }
         else if (key == 'r' && flag)
         {
-            playerTurn(key, cheatFlag); // Display the Player's inventory
+            playerTurn(key, m_cheated); // Display the Player's inventory
             flag = false; // Set the inventory flag to be false
 
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
             m_dungeon->player()->readScroll(key); // Player attempts to read Scroll
             monsterTurn(); // Let monsters all take their turn
 
             // Display the new Game state
-            clearScreen();
-            m_dungeon->display();
+            if (m_render)
+            {
+                drawDungeon("");
+            }
             flag = true; // After one turn, we can reenter the inventory if we wish
 
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
         }
         else if (key == 'w' && flag)
         {
-            playerTurn(key, cheatFlag); // Display the Player's inventory
+            playerTurn(key, m_cheated); // Display the Player's inventory
             flag = false; // Set the inventory flag to be false
 
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
             m_dungeon->player()->wieldWeapon(key); // Player attempts to wield Weapon
             monsterTurn(); // Let monsters all take their turn
 
             // Display the new Game state
-            clearScreen();
-            m_dungeon->display();
+            if (m_render)
+            {
+                drawDungeon("");
+            }
             flag = true; // After one turn, we can reenter the inventory if we wish
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
         }
         else
         {
@@ -285,23 +596,22 @@ void Game::play()
             if (m_dungeon->getStatus(prow, pcol) == ACTORITEM && key == '>')
             {
                 int index = m_dungeon->itemAtPos(prow, pcol);
-                std::string itemType = m_dungeon->getAvailItems()[index]->getType();
+                const std::string& itemType = m_dungeon->getAvailItems()[index]->getType();
 
                 if (itemType == "Stairway")
                 {
-                    playerTurn(key, cheatFlag); // Player descends down the stairway
-                    clearScreen(); // Clear the screen
+                    playerTurn(key, m_cheated); // Player descends down the stairway
                 }
                 else
                 {
-                    playerTurn(key, cheatFlag); // Make a normal move
+                    playerTurn(key, m_cheated); // Make a normal move
                     monsterTurn(); // Let monsters all take their turn
                 }
             }
             else
             {
                 // Normal Game turn ensues
-                playerTurn(key, cheatFlag);
+                playerTurn(key, m_cheated);
                 monsterTurn();
             }
             
@@ -311,25 +621,80 @@ void Game::play()
             if (m_dungeon->player()->isWinner())
             {
                 // Display the final Game state
-                clearScreen();
-                m_dungeon->display();
-                
-                std::cout << "Congratulations, you won!" << std::endl;
+                if (m_render)
+                {
+                    drawDungeon("Congratulations, you won!\n");
+                }
                 break;
             }
 
-            // Display the new Game state
-            clearScreen();
-            m_dungeon->display();
+            // Display the new Game state, with the death notice if the Player died
+            if (m_render)
+            {
+                drawDungeon(m_dungeon->player()->isDead() ? "You died!\n" : "");
+            }
 
             // If the Player is dead, break out of the loop
             if (m_dungeon->player()->isDead())
             {
-                std::cout << "You died!" << std::endl;
                 break;
             }
 
-            key = getCharacter(); // Retrieve the next turn keyboard input
+            key = nextKey(); // Retrieve the next turn keyboard input
         }
     }
+
+    // Report how the Game ended
+    GameResult result;
+    result.turns = m_turns;
+    result.level = m_dungeon->getLevel();
+
+    if (m_dungeon->player()->isWinner())
+    {
+        result.outcome = GAME_WON;
+    }
+    else if (m_dungeon->player()->isDead())
+    {
+        result.outcome = GAME_DIED;
+    }
+    else
+    {
+        result.outcome = GAME_QUIT;
+    }
+
+    return(result);
+}
+
+// Private Helper Function: gathers the Game's state, as it is saved
+void Game::gather(SaveData& data) const
+{
+    m_dungeon->save(data);
+    data.header.turns = m_turns;
+    data.header.cheated = m_cheated;
+}
+
+// Private Helper Function: draws the Dungeon, followed by the footer, as one frame
+void Game::drawDungeon(const std::string& footer)
+{
+    m_frame.clear();
+    m_dungeon->display(m_frame);
+    m_frame += footer;
+    m_renderer.present(m_frame);
+}
+
+// Private Helper Function: draws the Player's inventory as one frame
+void Game::drawInventory()
+{
+    m_frame.clear();
+    m_dungeon->player()->dispInventory(m_frame);
+    m_renderer.present(m_frame);
+}
+
+// Private Helper Function: draws the most recent Messages as one frame
+void Game::drawHistory()
+{
+    m_frame.clear();
+    m_frame += "Messages: \n";
+    m_dungeon->messages().displayHistory(m_frame, HISTORYLINES);
+    m_renderer.present(m_frame);
 }
\ No newline at end of file
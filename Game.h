@@ -3,6 +3,14 @@
 #ifndef GAME_INCLUDED
 #define GAME_INCLUDED
 
+#include "ActivitySet.h"
+#include "Renderer.h"
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
 /*
  Game Design Notes:
  - By program design, dynamic cast is not used within this project, as I preferred to 
@@ -13,23 +21,87 @@
    status of each cell, as well as display the state of the Game.
  - The Game class is the predominant driver code for this project. It's tasks include making
    sure that functions are not called inappropriately and that play is smooth.
+ - A Game may be given a seed, in which case the same seed and keys always play out the
+   same way. Otherwise it is seeded from the system's random device.
+ - The Game can also be run headlessly: keys come from a string, stream or callback instead
+   of the keyboard, nothing is drawn, and the outcome is returned as a GameResult. This is
+   used to play many Games at full speed (e.g. for balance and regression testing).
+ - When drawn, each screen is built as one frame (Dungeon or inventory, plus any closing
+   line) and handed to the Game's Renderer, rather than clearing and writing the terminal.
+ - A Game can be saved to a binary file and loaded back (see SaveFile), from code or with
+   the save and load keys, neither of which takes a turn. A loaded Game replaces the
+   current one entirely, and plays on exactly as the saved Game would have.
+ - A Game can record every key it reads to a replay log (see Replay), from the state it
+   was in when recording started; a Game played at the terminal always does. Re-running
+   the log reproduces the Game, and stateHash() checks that it ended in the same state.
 */
 
+// Game Outcome Constants
+const int GAME_WON = 0; // The Player picked up the golden idol
+const int GAME_DIED = 1; // The Player was killed
+const int GAME_QUIT = 2; // The Player quit (or the commands ran out)
+
+// Game Keys that do not take a turn
+const char SAVE_KEY = 'S'; // Saves the Game to the save file
+const char LOAD_KEY = 'L'; // Replaces the Game with the one in the save file
+
+// The result of a finished Game
+struct GameResult
+{
+    int outcome; // How the Game ended (GAME_WON, GAME_DIED or GAME_QUIT)
+    int turns; // The number of turns the Player took
+    int level; // The deepest Dungeon level reached
+};
+
 class Dungeon; // Indicates to compiler that Dungeon is a class
+class ReplayRecorder; // Indicates to compiler that ReplayRecorder is a class
+class SaveFile; // Indicates to compiler that SaveFile is a class
+struct SaveData; // Indicates to compiler that SaveData is a struct
 
 class Game
 {
 public:
     // Constructors and Destructors
     Game(int goblinSmellDistance);
+    Game(int goblinSmellDistance, std::uint64_t seed); // Seeded Games are reproducible
+    Game(int goblinSmellDistance, std::uint64_t seed, int rows, int cols); // Sized Dungeons
     ~Game();
 
+    // Accessor Functions
+    std::uint64_t getSeed() const; // Retrieves the seed the Game was started from
+    bool save(const std::string& path) const; // Saves the Game, returning false on failure
+    std::uint64_t stateHash() const; // Retrieves a hash of the Game's whole state
+
     // Mutator Functions
     void play(); // Plays Game
+    GameResult runHeadless(const std::string& commands); // Plays Game from a command string
+    GameResult runHeadless(std::istream& commands); // Plays Game from a command stream
+    GameResult runHeadless(std::function<char()> nextKey); // Plays Game from a callback
     void playerTurn(char ckey, bool& cheat); // Takes Player turn
     void monsterTurn(); // Takes monsters' turn
+    bool load(const std::string& path); // Loads a saved Game in place of this one
+    void load(const SaveFile& file); // Loads an open save file in place of this one
+    void setSaveFile(const std::string& path); // Sets the save keys' file ("" turns them off)
+    bool startRecording(const std::string& path); // Records every key read to a replay log
+    void stopRecording(); // Finishes the replay log with the final state's hash
 private:
+    // Private Game Loop and Drawing Helper Functions
+    GameResult run(std::function<char()> nextKey, bool render);
+    void drawDungeon(const std::string& footer); // Draws the Dungeon and a closing line
+    void drawInventory(); // Draws the Player's inventory
+    void drawHistory(); // Draws the most recent Messages
+    void gather(SaveData& data) const; // Gathers the Game's state, as saved
+
     Dungeon* m_dungeon; // The Game's Dungeon
+    bool m_render; // Whether the Game is drawn to the screen
+    int m_turns; // The number of turns the Player has taken
+    bool m_cheated; // Whether the Player has already cheated
+    std::string m_saveFile; // The file the save and load keys use, or "" if they do nothing
+    ReplayRecorder* m_recorder; // Records the keys read to a replay log
+    Renderer m_renderer; // Sends each frame to the terminal, drawing only what changed
+    std::string m_frame; // The frame being drawn
+    std::vector<unsigned char> m_acting; // Which monsters are awake this turn, by table row
+    ActivitySet m_active; // Which monsters could act, so the rest are never visited
 };
 
 #endif // GAME_INCLUDED
\ No newline at end of file
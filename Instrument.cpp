@@ -0,0 +1,321 @@
+// Instrument.cpp
+
+#include "Instrument.h"
+#include "Actor.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+const int PHASECOUNT = static_cast<int>(InstrumentPhase::Count);
+
+// Latencies are bucketed eight to each power of two, up to 2^40ns (about 18 minutes)
+const int LATENCYSTEPS = 8;
+const int LATENCYBUCKETS = LATENCYSTEPS * 39;
+
+// The phases' names, as printed in the summary, in InstrumentPhase order
+static const char* const PHASENAMES[PHASECOUNT] =
+{
+    "other",
+    "playerTurn",
+    "goblinTurn",
+    "bogeymanTurn",
+    "snakewomanTurn",
+    "dragonTurn",
+    "attack",
+    "display",
+    "newLevel",
+    "levelGeneration"
+};
+
+// The counts of each phase
+// N.B. Atomics with constant initialisers are ready before any allocation can happen
+static std::atomic<long long> phaseAllocations[PHASECOUNT];
+static std::atomic<long long> phaseBytes[PHASECOUNT];
+static std::atomic<long long> phaseEntries[PHASECOUNT];
+
+// The latency histogram of each phase, and its slowest entry
+static std::atomic<long long> phaseLatencies[PHASECOUNT][LATENCYBUCKETS];
+static std::atomic<long long> phaseMaxLatency[PHASECOUNT];
+
+// The phase the calling thread is in
+static thread_local InstrumentPhase currentPhase = InstrumentPhase::Other;
+
+// Private Helper Function: Returns the histogram bucket a latency in nanoseconds falls in
+static int latencyBucket(long long nanos)
+{
+    // The first eight buckets hold one value each; after that, each power of two from
+    // 2^3 up is split into eight buckets, by the three bits below its highest bit
+    if (nanos < LATENCYSTEPS)
+    {
+        return(nanos > 0 ? static_cast<int>(nanos) : 0);
+    }
+
+    int exponent = 3;
+    while ((nanos >> (exponent + 1)) != 0)
+    {
+        exponent++;
+    }
+
+    int step = static_cast<int>((nanos >> (exponent - 3)) & (LATENCYSTEPS - 1));
+    int bucket = (exponent - 2) * LATENCYSTEPS + step;
+
+    return(bucket < LATENCYBUCKETS ? bucket : LATENCYBUCKETS - 1);
+}
+
+// Private Helper Function: Returns the largest latency the bucket holds
+static long long latencyBucketLimit(int bucket)
+{
+    if (bucket < LATENCYSTEPS)
+    {
+        return(bucket);
+    }
+
+    int exponent = bucket / LATENCYSTEPS + 2;
+    long long width = 1LL << (exponent - 3);
+
+    return((LATENCYSTEPS + bucket % LATENCYSTEPS) * width + width - 1);
+}
+
+// Accessor: returns the allocations counted in every phase
+long long Instrument::getAllocations()
+{
+    long long total = 0;
+
+    for (int p = 0; p < PHASECOUNT; p++)
+    {
+        total += phaseAllocations[p].load(std::memory_order_relaxed);
+    }
+
+    return(total);
+}
+
+// Accessor: returns the allocations counted in the phase
+long long Instrument::getAllocations(InstrumentPhase phase)
+{
+    return(phaseAllocations[static_cast<int>(phase)].load(std::memory_order_relaxed));
+}
+
+// Accessor: returns the bytes requested in the phase
+long long Instrument::getBytes(InstrumentPhase phase)
+{
+    return(phaseBytes[static_cast<int>(phase)].load(std::memory_order_relaxed));
+}
+
+// Accessor: returns the number of times the phase was entered
+long long Instrument::getEntries(InstrumentPhase phase)
+{
+    return(phaseEntries[static_cast<int>(phase)].load(std::memory_order_relaxed));
+}
+
+// Accessor: returns the latency in nanoseconds that the fraction of the phase's entries
+// took no longer than (to within a bucket), e.g. 0.99 for the 99th percentile
+long long Instrument::getLatency(InstrumentPhase phase, double fraction)
+{
+    const std::atomic<long long>* buckets = phaseLatencies[static_cast<int>(phase)];
+    long long total = 0;
+
+    for (int b = 0; b < LATENCYBUCKETS; b++)
+    {
+        total += buckets[b].load(std::memory_order_relaxed);
+    }
+
+    if (total == 0)
+    {
+        return(0);
+    }
+
+    // Find the bucket holding the entry at that rank, counting up from the fastest
+    long long rank = static_cast<long long>(std::ceil(fraction * total));
+    rank = (rank < 1) ? 1 : rank;
+    long long seen = 0;
+
+    for (int b = 0; b < LATENCYBUCKETS; b++)
+    {
+        seen += buckets[b].load(std::memory_order_relaxed);
+
+        if (seen >= rank)
+        {
+            // The bucket's limit can overshoot the slowest entry actually recorded
+            long long limit = latencyBucketLimit(b);
+            long long slowest = getMaxLatency(phase);
+            return(limit < slowest ? limit : slowest);
+        }
+    }
+
+    return(getMaxLatency(phase));
+}
+
+// Accessor: returns the latency in nanoseconds of the phase's slowest entry
+long long Instrument::getMaxLatency(InstrumentPhase phase)
+{
+    return(phaseMaxLatency[static_cast<int>(phase)].load(std::memory_order_relaxed));
+}
+
+// Accessor: returns the phase of the monster kind's turn
+InstrumentPhase Instrument::monsterPhase(ActorKind kind)
+{
+    switch (kind)
+    {
+    case ActorKind::Goblin:
+        return(InstrumentPhase::GoblinTurn);
+    case ActorKind::Bogeyman:
+        return(InstrumentPhase::BogeymanTurn);
+    case ActorKind::Snakewoman:
+        return(InstrumentPhase::SnakewomanTurn);
+    case ActorKind::Dragon:
+        return(InstrumentPhase::DragonTurn);
+    default:
+        return(InstrumentPhase::PlayerTurn);
+    }
+}
+
+// Accessor: prints each phase's entries, allocations and bytes, and the per-entry averages
+void Instrument::report(std::ostream& out)
+{
+    // Read the counts first, so that printing them is not counted in them
+    long long allocations[PHASECOUNT];
+    long long bytes[PHASECOUNT];
+    long long entries[PHASECOUNT];
+
+    for (int p = 0; p < PHASECOUNT; p++)
+    {
+        allocations[p] = getAllocations(static_cast<InstrumentPhase>(p));
+        bytes[p] = getBytes(static_cast<InstrumentPhase>(p));
+        entries[p] = getEntries(static_cast<InstrumentPhase>(p));
+    }
+
+    out << "Allocations by phase:\n";
+
+    for (int p = 0; p < PHASECOUNT; p++)
+    {
+        out << "  " << PHASENAMES[p] << ": entries=" << entries[p]
+            << " allocations=" << allocations[p] << " bytes=" << bytes[p];
+
+        if (entries[p] > 0)
+        {
+            out << " (" << double(allocations[p]) / entries[p] << " allocations, "
+                << double(bytes[p]) / entries[p] << " bytes per entry)";
+        }
+
+        out << "\n";
+    }
+
+    out << "Latency by phase (ns):\n";
+
+    for (int p = 0; p < PHASECOUNT; p++)
+    {
+        InstrumentPhase phase = static_cast<InstrumentPhase>(p);
+
+        if (getEntries(phase) == 0)
+        {
+            continue; // The phase was never timed
+        }
+
+        out << "  " << PHASENAMES[p] << ": p50=" << getLatency(phase, 0.50)
+            << " p95=" << getLatency(phase, 0.95) << " p99=" << getLatency(phase, 0.99)
+            << " max=" << getMaxLatency(phase) << "\n";
+    }
+
+    out.flush();
+}
+
+// Mutator: counts an allocation of the given size against the calling thread's phase
+void Instrument::recordAllocation(std::size_t size)
+{
+    int p = static_cast<int>(currentPhase);
+    phaseAllocations[p].fetch_add(1, std::memory_order_relaxed);
+    phaseBytes[p].fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+}
+
+// Mutator: counts an entry to the phase that took the given time in its histogram
+void Instrument::recordLatency(InstrumentPhase phase, long long nanos)
+{
+    int p = static_cast<int>(phase);
+    phaseLatencies[p][latencyBucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+
+    // Raise the maximum, unless another thread has already raised it further
+    long long slowest = phaseMaxLatency[p].load(std::memory_order_relaxed);
+    while (nanos > slowest &&
+        !phaseMaxLatency[p].compare_exchange_weak(slowest, nanos, std::memory_order_relaxed))
+    {
+    }
+}
+
+// Mutator: clears every count
+void Instrument::reset()
+{
+    for (int p = 0; p < PHASECOUNT; p++)
+    {
+        phaseAllocations[p].store(0, std::memory_order_relaxed);
+        phaseBytes[p].store(0, std::memory_order_relaxed);
+        phaseEntries[p].store(0, std::memory_order_relaxed);
+        phaseMaxLatency[p].store(0, std::memory_order_relaxed);
+
+        for (int b = 0; b < LATENCYBUCKETS; b++)
+        {
+            phaseLatencies[p][b].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Private Helper Function: makes the phase current, returning the one it replaces
+InstrumentPhase Instrument::enter(InstrumentPhase phase)
+{
+    phaseEntries[static_cast<int>(phase)].fetch_add(1, std::memory_order_relaxed);
+
+    InstrumentPhase previous = currentPhase;
+    currentPhase = phase;
+    return(previous);
+}
+
+// Private Helper Function: restores the enclosing phase
+void Instrument::leave(InstrumentPhase previous)
+{
+    currentPhase = previous;
+}
+
+// PhaseScope constructor with parameter phase
+PhaseScope::PhaseScope(InstrumentPhase phase)
+{
+    m_phase = phase;
+    m_previous = Instrument::enter(phase);
+    m_start = std::chrono::steady_clock::now(); // Start the clock last, to time only the phase
+}
+
+// PhaseScope destructor
+PhaseScope::~PhaseScope()
+{
+    std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_start;
+    Instrument::recordLatency(m_phase,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    Instrument::leave(m_previous);
+}
+
+#if defined(MINIROGUE_INSTRUMENT) || defined(MINIROGUE_BENCHMARK)
+// Count every allocation against the current phase
+void* operator new(std::size_t size)
+{
+    Instrument::recordAllocation(size);
+
+    void* memory = std::malloc(size == 0 ? 1 : size);
+
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return(memory);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Instrument.h
+
+#ifndef INSTRUMENT_INCLUDED
+#define INSTRUMENT_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+
+/*
+ Instrument Design Notes:
+ - Instrument counts heap allocations, and the bytes they request, by the phase of the
+   Game that made them: the Player's turn, each monster kind's turn, attacks, drawing the
+   Dungeon, taking a stairway and generating a level. Anything outside those phases is
+   counted as "other".
+ - It also times every entry to a phase, into a fixed histogram per phase, so that the
+   summary can give the median, 95th and 99th percentile and worst latencies. Averages
+   hide the rare slow turn (e.g. a Goblin searching a large smell distance); percentiles
+   do not. The buckets are spaced eight to each power of two, so a percentile is within
+   an eighth of the true value, and recording one is a single counter increment.
+ - It is opt-in. Build with MINIROGUE_INSTRUMENT defined to replace the global operator
+   new with a counting one and to mark and time the phases; otherwise INSTRUMENT_PHASE
+   expands to nothing and the Game pays no cost. The benchmark build also counts
+   allocations (for its per-turn total), but does not mark phases.
+ - Phases nest. A PhaseScope marks the phase until it goes out of scope, then restores the
+   enclosing one, so each allocation is counted once, against the innermost phase (e.g. a
+   level generated during the Player's turn counts as level generation). A phase's time,
+   however, includes the time of the phases nested inside it.
+ - The current phase is kept per thread and the counts are atomic, so the Simulator's
+   threads may all be counted together.
+*/
+
+enum class ActorKind; // Indicates to compiler that ActorKind is an enum
+
+// The debug key that shows the summary during a Game (only with MINIROGUE_INSTRUMENT)
+const char INSTRUMENT_KEY = '#';
+
+// Instrumented Game Phases
+enum class InstrumentPhase
+{
+    Other,
+    PlayerTurn,
+    GoblinTurn,
+    BogeymanTurn,
+    SnakewomanTurn,
+    DragonTurn,
+    Attack,
+    Display,
+    NewLevel,
+    LevelGeneration,
+    Count // The number of phases
+};
+
+class Instrument
+{
+public:
+    // Accessor Functions
+    static long long getAllocations(); // Retrieve the allocations counted in every phase
+    static long long getAllocations(InstrumentPhase phase); // ... counted in the phase
+    static long long getBytes(InstrumentPhase phase); // Retrieve the bytes requested
+    static long long getEntries(InstrumentPhase phase); // Retrieve the times it was entered
+    static long long getLatency(InstrumentPhase phase, double fraction); // ... percentile
+    static long long getMaxLatency(InstrumentPhase phase); // Retrieve the slowest entry
+    static InstrumentPhase monsterPhase(ActorKind kind); // Retrieve the kind's turn phase
+    static void report(std::ostream& out); // Prints a summary, one line per phase
+
+    // Mutator Functions
+    static void recordAllocation(std::size_t size); // Counts against the current phase
+    static void recordLatency(InstrumentPhase phase, long long nanos); // Times an entry
+    static void reset(); // Clears every count
+private:
+    friend class PhaseScope;
+    static InstrumentPhase enter(InstrumentPhase phase); // Returns the enclosing phase
+    static void leave(InstrumentPhase previous); // Restores the enclosing phase
+};
+
+// Marks and times the phase for as long as the PhaseScope lives
+class PhaseScope
+{
+public:
+    // Constructors and Destructors
+    PhaseScope(InstrumentPhase phase);
+    ~PhaseScope();
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+private:
+    InstrumentPhase m_phase; // The phase the scope marks
+    InstrumentPhase m_previous; // The phase to restore when the scope ends
+    std::chrono::steady_clock::time_point m_start; // When the scope began
+};
+
+// Marks the rest of the enclosing block as the phase (only with MINIROGUE_INSTRUMENT)
+#ifdef MINIROGUE_INSTRUMENT
+#define INSTRUMENT_PHASE(phase) PhaseScope instrumentPhaseScope(phase)
+#else
+#define INSTRUMENT_PHASE(phase) ((void)0)
+#endif
+
+#endif // INSTRUMENT_INCLUDED
\ No newline at end of file
@@ -3,9 +3,48 @@
 #include "Actor.h"
 #include "Dungeon.h"
 #include "Item.h"
-#include "utilities.h"
 #include <iostream>
 
+// The traits of each Item kind, in the order of the ItemKind enum
+static const ItemTraits ITEMTRAITS[] =
+{
+	{ "", "", "", "" },
+	{ "mace", "mace", "swings mace at the ", "" },
+	{ "short sword", "short sword", "slashes short sword at the ", "" },
+	{ "long sword", "long sword", "swings long sword at the ", "" },
+	{ "magic axe", "magic axe", "chops magic axe at ", "" },
+	{ "magic fangs", "magic fangs of sleep", "strikes magic fangs at ", "" },
+	{ "teleportation", "teleportation", "", "You feel your body wrenched in space and time." },
+	{ "improve armor", "improve armor", "", "Your armor glows blue." },
+	{ "strength", "strength", "", "Your muscles bulge." },
+	{ "enhance health", "enhance health", "", "You feel your heart beating stronger." },
+	{ "enhance dexterity", "enhance dexterity", "", "You feel like less of a klutz." },
+	{ "Stairway", "Stairway", "", "" },
+	{ "Golden Idol", "golden idol", "", "" }
+};
+
+const int ITEMKINDS = sizeof(ITEMTRAITS) / sizeof(ITEMTRAITS[0]);
+
+// Accessor: returns the traits of the given Item kind
+const ItemTraits& getItemTraits(ItemKind kind)
+{
+	return(ITEMTRAITS[static_cast<int>(kind)]);
+}
+
+// Accessor: returns the Item kind with the given name, or None if there is no such kind
+ItemKind getItemKind(const std::string& name)
+{
+	for (int k = 1; k < ITEMKINDS; k++)
+	{
+		if (name == ITEMTRAITS[k].name)
+		{
+			return(static_cast<ItemKind>(k));
+		}
+	}
+
+	return(ItemKind::None);
+}
+
 /////////////////////////////////////
 // Item Class Implementation
 /////////////////////////////////////
@@ -17,6 +56,7 @@ Item::Item(Dungeon* d, Actor* a, std::string name, int sr, int sc)
 	m_dungeon = d;
 	m_player = a;
 	m_name = name;
+	m_itemKind = ::getItemKind(name);
 	m_rcoord = sr;
 	m_ccoord = sc;
 
@@ -69,17 +109,29 @@ Dungeon* Item::getItemDungeon() const
 }
 
 // Accessor: returns the Item's name
-std::string Item::getName() const
+const std::string& Item::getName() const
 {
 	return(m_name);
 }
 
 // Accessor: returns the Item's class
-std::string Item::getType() const
+const std::string& Item::getType() const
 {
 	return(m_itemType);
 }
 
+// Accessor: returns the Item's kind
+ItemKind Item::getItemKind() const
+{
+	return(m_itemKind);
+}
+
+// Accessor: returns the Scroll's rolled bonus; other Items have none
+int Item::getScrollBonus() const
+{
+	return(0);
+}
+
 // Mutator: sets the Item's type
 void Item::setItemType(std::string type)
 {
@@ -92,6 +144,17 @@ void Item::setOwner(Actor* player)
 	m_player = player;
 }
 
+// Mutator: moves the Item to another Dungeon (e.g. one that took over its level)
+void Item::setItemDungeon(Dungeon* d)
+{
+	m_dungeon = d;
+}
+
+// Mutator: sets the Scroll's bonus; other Items have none, so this does nothing
+void Item::setScrollBonus(int)
+{
+}
+
 // Mutator: sets the Item's damage bonus
 void Item::setWeaponDamage(int damage)
 {
@@ -143,6 +206,12 @@ Weapon::~Weapon()
 	// Weapon has nothing special to delete, therefore its destructor body is empty.
 }
 
+// Accessor: returns a heap copy of the weapon (e.g. to outlive the level's Arena)
+Item* Weapon::clone() const
+{
+	return(new Weapon(*this));
+}
+
 // Mutator: In Weapon's case, it is declared to ensure Weapon is not an abstract base class
 void Weapon::wieldItem()
 {
@@ -169,15 +238,15 @@ Scroll::Scroll(Dungeon* d, Actor* a, std::string name, int sr, int sc)
 	// N.B. Teleportation scrolls have no boosts. They merely move the player.
 	if (name == "improve armor")
 	{
-		m_sarmor = randInt(1, 3);
+		m_sarmor = getItemDungeon()->rng().randInt(1, 3);
 	}
 	else if (name == "strength")
 	{
-		m_sstrength = randInt(1, 3);
+		m_sstrength = getItemDungeon()->rng().randInt(1, 3);
 	}
 	else if (name == "enhance health")
 	{
-		m_smaxHP = randInt(3, 8);
+		m_smaxHP = getItemDungeon()->rng().randInt(3, 8);
 	}
 	else if (name == "enhance dexterity")
 	{
@@ -191,43 +260,53 @@ Scroll::~Scroll()
 	// Scroll has nothing special to delete, therefore its destructor body is empty.
 }
 
+// Accessor: returns a heap copy of the scroll (e.g. to outlive the level's Arena)
+Item* Scroll::clone() const
+{
+	return(new Scroll(*this));
+}
+
+// Accessor: returns the bonus the scroll rolled when it was created
+int Scroll::getScrollBonus() const
+{
+	// N.B. Only the bonus matching the scroll's name is ever nonzero
+	return(m_sdexterity + m_smaxHP + m_sstrength + m_sarmor);
+}
+
 // Mutator: In Scroll's case, the scroll is read
 void Scroll::wieldItem()
 {
 	// N.B. As only the player may call this, we will not follow the nullptr
 	
 	// Get the name of the scroll being read
-	std::string name = getName();
+	const std::string& name = getName();
 	
 	// Depending on the scroll type, adjust the player accordingly
 	if (name == "improve armor")
 	{
-		getItemOwner()->changeStats(m_sarmor, "Armor");
+		getItemOwner()->changeStats(m_sarmor, StatCategory::Armor);
 	}
 	else if (name == "strength")
 	{
-		getItemOwner()->changeStats(m_sstrength, "Strength");
+		getItemOwner()->changeStats(m_sstrength, StatCategory::Strength);
 	}
 	else if (name == "enhance health")
 	{
-		getItemOwner()->changeStats(m_smaxHP, "Max HP");
+		getItemOwner()->changeStats(m_smaxHP, StatCategory::MaxHP);
 	}
 	else if (name == "enhance dexterity")
 	{
-		getItemOwner()->changeStats(m_sdexterity, "Dexterity");
+		getItemOwner()->changeStats(m_sdexterity, StatCategory::Dexterity);
 	}
 	else // name == "teleportation"
 	{
-		// Determine new Player coordinates
-		int rnew = randInt(1, getItemDungeon()->getRow() - 2);
-		int cnew = randInt(1, getItemDungeon()->getCol() - 2);
+		// Determine new Player coordinates; if every cell is taken, the Player stays put
+		int rnew;
+		int cnew;
 
-		// While the coordinates are invalid, keep resetting
-		while (getItemDungeon()->getStatus(rnew, cnew) != EMPTY &&
-			   getItemDungeon()->getStatus(rnew, cnew) != ITEM)
+		if (!getItemDungeon()->randomActorCell(rnew, cnew))
 		{
-			rnew = randInt(1, getItemDungeon()->getRow() - 2);
-			cnew = randInt(1, getItemDungeon()->getCol() - 2);
+			return;
 		}
 
 		// Determine the difference between the new and current coordinates
@@ -237,6 +316,29 @@ void Scroll::wieldItem()
 	}
 }
 
+// Mutator: sets the scroll's bonus, in place of the one it rolled (e.g. when loading a Game)
+void Scroll::setScrollBonus(int bonus)
+{
+	const std::string& name = getName();
+
+	if (name == "improve armor")
+	{
+		m_sarmor = bonus;
+	}
+	else if (name == "strength")
+	{
+		m_sstrength = bonus;
+	}
+	else if (name == "enhance health")
+	{
+		m_smaxHP = bonus;
+	}
+	else if (name == "enhance dexterity")
+	{
+		m_sdexterity = bonus;
+	}
+}
+
 /////////////////////////////////////
 // SpecialItem Class Implementation
 /////////////////////////////////////
@@ -255,6 +357,12 @@ SpecialItem::~SpecialItem()
 	// SpecialItem has nothing special to delete, therefore its destructor body is empty.
 }
 
+// Accessor: returns a heap copy of the special item (e.g. to outlive the level's Arena)
+Item* SpecialItem::clone() const
+{
+	return(new SpecialItem(*this));
+}
+
 // Mutator: In SpecialItem's case, it is declared to ensure it is not an abstract base class
 void SpecialItem::wieldItem()
 {
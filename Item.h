@@ -21,6 +21,10 @@
  - Item's are made distinguishable by their m_itemType data member. This will be set to 
    either "Weapon", or "Scroll". 
  - Item's name is the actual name of the Item (e.g. "mace", "improve armor", etc.).
+ - Each Item also has an ItemKind, looked up from its name when it is created, so that
+   the hot paths (attacks, messages) compare integers rather than names. The text that
+   goes with each kind (e.g. the attack phrase of a weapon, or what reading a scroll
+   feels like) is kept in one table of ItemTraits, indexed by kind.
  - Scroll's wieldItem() function (which reads the scroll), will adjust the player's stats
    accordingly, thus there is no need for those data members to be in the Item class.
  - Special Item's have no data members, as you cannot do anything with them.
@@ -31,6 +35,36 @@
 class Dungeon; // Indicates to compiler that Dungeon is a class
 class Actor; // Indicates to compiler that Actor is a class
 
+// Item Kinds
+enum class ItemKind
+{
+	None, // No Item (e.g. in a message that involves none)
+	Mace,
+	ShortSword,
+	LongSword,
+	MagicAxe,
+	MagicFangs,
+	Teleportation,
+	ImproveArmor,
+	Strength,
+	EnhanceHealth,
+	EnhanceDexterity,
+	Stairway,
+	GoldenIdol
+};
+
+// The fixed traits of each Item kind
+struct ItemTraits
+{
+	const char* name; // The kind's name, as the Item is created with
+	const char* displayName; // The kind's name, as shown in messages
+	const char* attackPhrase; // How the Player attacks with the kind (weapons only)
+	const char* readText; // What the Player feels on reading the kind (scrolls only)
+};
+
+const ItemTraits& getItemTraits(ItemKind kind); // Retrieve the traits of the kind
+ItemKind getItemKind(const std::string& name); // Retrieve the kind with the given name
+
 // Abstract Base Class
 class Item
 {
@@ -46,16 +80,21 @@ public:
 	int getWeaponDexterity() const; // Retrieve the weapon's dexterity bonus
 	Actor* getItemOwner() const; // Retrieve the item's owner, or it will return nullptr
 	Dungeon* getItemDungeon() const; // Retrieve the item's dungeon
-	std::string getName() const; // Retrieve the item's name
-	std::string getType() const; // Retrieve the item's type
+	const std::string& getName() const; // Retrieve the item's name
+	const std::string& getType() const; // Retrieve the item's type
+	ItemKind getItemKind() const; // Retrieve the item's kind
+	virtual int getScrollBonus() const; // Retrieve the scroll's rolled bonus (zero otherwise)
 
 	// Mutator Functions
 	void setItemType(std::string type); // Sets the item to either a weapon or scroll
 	void setOwner(Actor* player); // Sets the item owner to the player
+	void setItemDungeon(Dungeon* d); // Moves the item to another dungeon
 	void setWeaponDamage(int damage); // Sets the weapon's damage bonus
 	void setWeaponDexterity(int dexterity); // Sets the weapon's dexterity bonus
+	virtual void setScrollBonus(int bonus); // Sets the scroll's bonus (does nothing otherwise)
 
 	// Pure Virtual Functions
+	virtual Item* clone() const = 0; // Copies the item onto the heap
 	virtual void wieldItem() = 0; // Only weapons and scrolls can be wielded/read
 private:
 	int m_rcoord; // The Item's row coordinate
@@ -64,6 +103,7 @@ private:
 	Dungeon* m_dungeon; // The Item's dungeon
 	std::string m_name; // The Item's name (forms the display action string)
 	std::string m_itemType; // The Item's type
+	ItemKind m_itemKind; // The Item's kind
 
 	// Weapon-Specific Characteristics
 	int m_ddexterity; // The Weapon's dexterity bonus
@@ -78,6 +118,9 @@ public:
 	Weapon(Dungeon* d, Actor* a, std::string name, int sr, int sc);
 	virtual ~Weapon();
 
+	// Accessor Functions
+	virtual Item* clone() const; // Copies the weapon onto the heap
+
 	// Mutator Functions
 	virtual void wieldItem(); // Wields the weapon
 };
@@ -90,8 +133,13 @@ public:
 	Scroll(Dungeon* d, Actor* a, std::string name, int sr, int sc);
 	virtual ~Scroll();
 
+	// Accessor Functions
+	virtual Item* clone() const; // Copies the scroll onto the heap
+	virtual int getScrollBonus() const; // Retrieve the scroll's rolled bonus
+
 	// Mutator Functions
 	virtual void wieldItem(); // Reads the scroll
+	virtual void setScrollBonus(int bonus); // Sets the scroll's bonus (e.g. on loading)
 private:
 	int m_sdexterity; // Bonus in dexterity
 	int m_smaxHP; // Bonus in maximum HP
@@ -107,6 +155,9 @@ public:
 	SpecialItem(Dungeon* d, Actor* a, std::string name, int pr, int pc);
 	virtual ~SpecialItem();
 
+	// Accessor Functions
+	virtual Item* clone() const; // Copies the special item onto the heap
+
 	// Mutator Functions
 	virtual void wieldItem(); // Activate the stairwell or win the game
 };
@@ -0,0 +1,288 @@
+// MessageLog.cpp
+
+#include "MessageLog.h"
+#include "Actor.h"
+#include "Item.h"
+
+// The default number of Messages held; the rest of the history is overwritten
+const int MESSAGELOGSIZE = 256;
+
+// Where each Message is shown on screen, in the order the slots are drawn
+const int SLOTATTACK = 0;
+const int SLOTPICKUP = 1;
+const int SLOTWIELD = 2;
+const int SLOTREAD = 3;
+const int SLOTMONSTER = 4;
+
+// The slot of each Message, in the order of the MessageId enum
+static const int MESSAGESLOTS[] =
+{
+    SLOTATTACK, SLOTATTACK, SLOTATTACK, SLOTATTACK,
+    SLOTPICKUP, SLOTPICKUP, SLOTPICKUP, SLOTPICKUP,
+    SLOTWIELD, SLOTWIELD,
+    SLOTREAD, SLOTREAD,
+    SLOTMONSTER, SLOTMONSTER, SLOTMONSTER, SLOTMONSTER
+};
+
+// MessageLog default constructor
+MessageLog::MessageLog()
+    : MessageLog(MESSAGELOGSIZE)
+{
+}
+
+// MessageLog constructor with parameter capacity
+MessageLog::MessageLog(int capacity)
+{
+    m_ring.resize(capacity > 0 ? capacity : 1);
+    m_posted = 0;
+    m_playerStart = 0;
+    m_monsterStart = 0;
+}
+
+// Accessor: returns the number of Messages still held
+int MessageLog::size() const
+{
+    long long capacity = static_cast<long long>(m_ring.size());
+    return(static_cast<int>(m_posted < capacity ? m_posted : capacity));
+}
+
+// Accessor: returns the Message posted age Messages before the newest
+const Message& MessageLog::recent(int age) const
+{
+    // N.B. By design, assume that the higher code asks for fewer than size() Messages
+    return(m_ring[(m_posted - 1 - age) % static_cast<long long>(m_ring.size())]);
+}
+
+// Accessor: returns how many of the held Messages were posted since the Player's turn began
+int MessageLog::playerTurnSize() const
+{
+    long long posted = m_posted - m_playerStart;
+    return(static_cast<int>(posted < size() ? posted : size()));
+}
+
+// Accessor: returns how many of the held Messages were posted since the monsters' turn began
+int MessageLog::monsterTurnSize() const
+{
+    long long posted = m_posted - m_monsterStart;
+    return(static_cast<int>(posted < size() ? posted : size()));
+}
+
+// Accessor: draws the Messages of the current turn, one slot per line
+void MessageLog::display(std::string& frame) const
+{
+    // The Player's turn shows at most one Message of each kind (the last one posted)
+    for (int slot = SLOTATTACK; slot < SLOTMONSTER; slot++)
+    {
+        const Message* message = latest(m_playerStart, slot);
+
+        if (message != nullptr)
+        {
+            format(*message, frame);
+            frame += '\n';
+        }
+    }
+
+    // Every monster that attacked is shown, together on the last line
+    long long first = m_monsterStart;
+
+    if (m_posted - first > static_cast<long long>(size()))
+    {
+        first = m_posted - size(); // The oldest have been overwritten
+    }
+
+    bool any = false;
+
+    for (long long sequence = first; sequence < m_posted; sequence++)
+    {
+        const Message& message = recent(static_cast<int>(m_posted - 1 - sequence));
+
+        if (MESSAGESLOTS[static_cast<int>(message.id)] == SLOTMONSTER)
+        {
+            format(message, frame);
+            any = true;
+        }
+    }
+
+    if (any)
+    {
+        frame += '\n';
+    }
+}
+
+// Accessor: draws the last count Messages, oldest first, one per line
+void MessageLog::displayHistory(std::string& frame, int count) const
+{
+    if (count > size())
+    {
+        count = size();
+    }
+
+    for (int age = count - 1; age >= 0; age--)
+    {
+        size_t start = frame.size();
+        format(recent(age), frame);
+
+        // Monster Messages carry their own line breaks; keep one per Message
+        while (frame.size() > start && (frame.back() == '\n' || frame.back() == ' '))
+        {
+            frame.pop_back();
+        }
+        frame += '\n';
+    }
+}
+
+// Accessor: appends the text of the Message, as the Game shows it
+void MessageLog::format(const Message& message, std::string& text)
+{
+    const ItemTraits& item = getItemTraits(message.item);
+    const char* monster = getActorTraits(message.actor).name;
+
+    switch (message.id)
+    {
+    case MessageId::PlayerMisses:
+    case MessageId::PlayerHits:
+    case MessageId::PlayerPutsToSleep:
+    case MessageId::PlayerKills:
+        text += "Player ";
+        text += item.attackPhrase;
+        text += monster;
+
+        if (message.id == MessageId::PlayerMisses)
+        {
+            text += " and misses.";
+        }
+        else if (message.id == MessageId::PlayerHits)
+        {
+            text += " and hits.";
+        }
+        else if (message.id == MessageId::PlayerPutsToSleep)
+        {
+            text += " and hits, putting the ";
+            text += monster;
+            text += " to sleep.";
+        }
+        else
+        {
+            text += ", dealing a final blow.";
+        }
+        break;
+    case MessageId::PickUpWeapon:
+        text += "You pick up a ";
+        text += item.displayName;
+        text += ".";
+        break;
+    case MessageId::PickUpScroll:
+        text += "You pick up a scroll called scroll of ";
+        text += item.displayName;
+        text += ".";
+        break;
+    case MessageId::PickUpIdol:
+        text += "You pick up the golden idol.";
+        break;
+    case MessageId::KnapsackFull:
+        text += "Your knapsack is full; you can't pick that up.";
+        break;
+    case MessageId::WieldWeapon:
+        text += "You are wielding a ";
+        text += item.displayName;
+        text += ".";
+        break;
+    case MessageId::CannotWield:
+        text += "You can't wield a scroll of ";
+        text += item.displayName;
+        text += ".";
+        break;
+    case MessageId::ReadScroll:
+        text += "You read the scroll called scroll of ";
+        text += item.displayName;
+        text += ". \n";
+        text += item.readText;
+        break;
+    case MessageId::CannotRead:
+        text += "You can't read a ";
+        text += item.displayName;
+        text += ".";
+        break;
+    case MessageId::MonsterMisses:
+    case MessageId::MonsterHits:
+    case MessageId::MonsterPutsToSleep:
+    case MessageId::MonsterKills:
+        text += monster;
+        text += getActorTraits(message.actor).attackVerb;
+        text += "Player";
+
+        // N.B. Monster Messages share one line, so each ends its own (bar the sleep one)
+        if (message.id == MessageId::MonsterMisses)
+        {
+            text += " and misses. \n";
+        }
+        else if (message.id == MessageId::MonsterHits)
+        {
+            text += " and hits. \n";
+        }
+        else if (message.id == MessageId::MonsterPutsToSleep)
+        {
+            text += " and hits, putting the Player to sleep.";
+        }
+        else
+        {
+            text += ", dealing a final blow. \n";
+        }
+        break;
+    }
+}
+
+// Mutator: records a Message in the ring, overwriting the oldest once it is full
+void MessageLog::post(MessageId id, ActorKind actor, ItemKind item, int amount)
+{
+    Message& message = m_ring[m_posted % static_cast<long long>(m_ring.size())];
+    message.id = id;
+    message.actor = actor;
+    message.item = item;
+    message.amount = amount;
+    m_posted++;
+}
+
+// Mutator: starts the Player's turn, so that earlier Player Messages are no longer shown
+void MessageLog::startPlayerTurn()
+{
+    m_playerStart = m_posted;
+}
+
+// Mutator: starts the monsters' turn, so that earlier monster Messages are no longer shown
+void MessageLog::startMonsterTurn()
+{
+    m_monsterStart = m_posted;
+}
+
+// Mutator: forgets every Message
+void MessageLog::clear()
+{
+    m_posted = 0;
+    m_playerStart = 0;
+    m_monsterStart = 0;
+}
+
+// Mutator: marks the turns as having begun the given number of Messages ago
+void MessageLog::resumeTurns(int playerSize, int monsterSize)
+{
+    // N.B. Used once a saved history has been posted again, so both fit in what is held
+    m_playerStart = m_posted - playerSize;
+    m_monsterStart = m_posted - monsterSize;
+}
+
+// Private Helper Function: returns the newest Message in the slot posted since the sequence
+const Message* MessageLog::latest(long long since, int slot) const
+{
+    for (int age = 0; age < size() && m_posted - 1 - age >= since; age++)
+    {
+        const Message& message = recent(age);
+
+        if (MESSAGESLOTS[static_cast<int>(message.id)] == slot)
+        {
+            return(&message);
+        }
+    }
+
+    return(nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+// MessageLog.h
+
+#ifndef MESSAGELOG_INCLUDED
+#define MESSAGELOG_INCLUDED
+
+#include <string>
+#include <vector>
+
+/*
+ MessageLog Design Notes:
+ - MessageLog records what happens in the Game (attacks, pick ups, scrolls read, weapons
+   wielded) as small Message records: what happened, the Actor kind and Item kind involved
+   and any amount (e.g. the damage dealt). The text is only built when a frame is drawn,
+   so headless Games never build strings on the combat path.
+ - The records are kept in a fixed-capacity ring, allocated once, so posting a Message
+   never allocates. Once the ring is full, the oldest records are overwritten; what
+   remains is the scrollback history.
+ - The Game marks the start of the Player's turn and of the monsters' turn. The screen
+   shows the last Player Message of each kind (attack, pick up, wield, read) posted since
+   the Player's turn began, followed by every monster Message posted since the monsters'
+   turn began, just as the result strings used to be kept.
+*/
+
+enum class ActorKind; // Indicates to compiler that ActorKind is an enum
+enum class ItemKind; // Indicates to compiler that ItemKind is an enum
+
+// Message Identifiers
+enum class MessageId
+{
+    PlayerMisses, // The Player attacks a monster and misses
+    PlayerHits, // The Player attacks a monster and hits
+    PlayerPutsToSleep, // The Player hits a monster with magic fangs, which fall asleep
+    PlayerKills, // The Player deals a monster the final blow
+    PickUpWeapon, // The Player picks up a weapon
+    PickUpScroll, // The Player picks up a scroll
+    PickUpIdol, // The Player picks up the golden idol
+    KnapsackFull, // The Player's inventory is too full to pick up an Item
+    WieldWeapon, // The Player wields a weapon
+    CannotWield, // The Player tries to wield a scroll
+    ReadScroll, // The Player reads a scroll
+    CannotRead, // The Player tries to read a weapon
+    MonsterMisses, // A monster attacks the Player and misses
+    MonsterHits, // A monster attacks the Player and hits
+    MonsterPutsToSleep, // A monster hits the Player, who falls asleep
+    MonsterKills // A monster deals the Player the final blow
+};
+
+// A record of something that happened
+struct Message
+{
+    MessageId id; // What happened
+    ActorKind actor; // The monster involved (the Player's target, or the attacker)
+    ItemKind item; // The Item involved (the weapon used, or the Item picked up or used)
+    int amount; // The damage dealt, if any
+};
+
+class MessageLog
+{
+public:
+    // Constructors and Destructors
+    MessageLog(); // Uses the default capacity
+    MessageLog(int capacity);
+
+    // Accessor Functions
+    int size() const; // Retrieve the number of Messages still held
+    const Message& recent(int age) const; // Retrieve a Message (0 is the newest)
+    int playerTurnSize() const; // Retrieve how many held Messages the Player's turn posted
+    int monsterTurnSize() const; // Retrieve how many held Messages the monsters' turn posted
+    void display(std::string& frame) const; // Draws the current turn's Messages
+    void displayHistory(std::string& frame, int count) const; // Draws the last Messages
+    static void format(const Message& message, std::string& text); // Appends its text
+
+    // Mutator Functions
+    void post(MessageId id, ActorKind actor, ItemKind item, int amount); // Records one
+    void startPlayerTurn(); // Clears the Player's Messages from the screen
+    void startMonsterTurn(); // Clears the monsters' Messages from the screen
+    void clear(); // Forgets every Message
+    void resumeTurns(int playerSize, int monsterSize); // Marks the turns' starts (on load)
+private:
+    // Private Helper Functions
+    const Message* latest(long long since, int slot) const; // The newest in the slot
+
+    std::vector<Message> m_ring; // The Messages, in a ring of fixed capacity
+    long long m_posted; // The number of Messages ever posted (the next one's sequence)
+    long long m_playerStart; // The sequence of the Player's turn's first Message
+    long long m_monsterStart; // The sequence of the monsters' turn's first Message
+};
+
+#endif // MESSAGELOG_INCLUDED
\ No newline at end of file
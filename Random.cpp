@@ -0,0 +1,88 @@
+// Random.cpp
+
+#include "Random.h"
+#include <random>
+#include <utility>
+
+// Random default constructor, seeded from the system's random device
+Random::Random()
+{
+    std::random_device rd;
+    seed((std::uint64_t(rd()) << 32) | rd());
+}
+
+// Random constructor with parameter seed
+Random::Random(std::uint64_t seed)
+{
+    this->seed(seed);
+}
+
+// Accessor: returns the Random's starting seed
+std::uint64_t Random::getSeed() const
+{
+    return(m_seed);
+}
+
+// Accessor: returns the Random's engine state
+std::uint64_t Random::getState() const
+{
+    return(m_state);
+}
+
+// Mutator: restarts the sequence from the given seed
+void Random::seed(std::uint64_t seed)
+{
+    m_seed = seed;
+    m_state = seed;
+}
+
+// Mutator: resumes the sequence from a saved engine state
+void Random::setState(std::uint64_t state)
+{
+    m_state = state;
+}
+
+// Mutator: returns a uniformly distributed random integer from lowest to highest inclusive
+int Random::randInt(int lowest, int highest)
+{
+    if (highest < lowest)
+    {
+        std::swap(highest, lowest);
+    }
+
+    // Reject the top sliver of values that would bias the result toward small numbers
+    std::uint64_t range = std::uint64_t(std::int64_t(highest) - lowest) + 1;
+    std::uint64_t limit = UINT64_MAX - UINT64_MAX % range;
+    std::uint64_t value = next();
+
+    while (value >= limit)
+    {
+        value = next();
+    }
+
+    return(static_cast<int>(std::int64_t(lowest) + std::int64_t(value % range)));
+}
+
+// Mutator: returns a uniformly distributed random integer from 0 to limit-1 inclusive
+int Random::randInt(int limit)
+{
+    return(randInt(0, limit - 1));
+}
+
+// Mutator: returns true with a given probability
+bool Random::trueWithProbability(double p)
+{
+    // Use the top 53 bits to form a uniform double in [0, 1)
+    double value = (next() >> 11) * (1.0 / 9007199254740992.0);
+    return(value < p);
+}
+
+// Private Helper Function: advances the SplitMix64 engine
+std::uint64_t Random::next()
+{
+    m_state += 0x9E3779B97F4A7C15ULL;
+    std::uint64_t z = m_state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return(z ^ (z >> 31));
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Random.h
+
+#ifndef RANDOM_INCLUDED
+#define RANDOM_INCLUDED
+
+#include <cstdint>
+
+/*
+ Random Design Notes:
+ - Random is the random number context of a single Game. Every random decision in the
+   Game (layout, monster statistics, combat, drops, scrolls) draws from the Dungeon's
+   Random rather than from a shared global engine.
+ - Two Randoms built with the same seed produce the same sequence, so seeding a Game makes
+   it reproducible. As no state is shared between instances, separate Games may run on
+   separate threads.
+ - The engine is SplitMix64, and the conversions to integers and probabilities are done
+   here rather than by the standard library distributions, so a seed gives the same
+   sequence with every compiler.
+*/
+
+class Random
+{
+public:
+    // Constructors and Destructors
+    Random(); // Seeds from the system's random device
+    Random(std::uint64_t seed);
+
+    // Accessor Functions
+    std::uint64_t getSeed() const; // Retrieve the seed this Random started from
+    std::uint64_t getState() const; // Retrieve the engine's current state
+
+    // Mutator Functions
+    void seed(std::uint64_t seed); // Restarts the sequence from the given seed
+    void setState(std::uint64_t state); // Resumes the sequence from a saved state
+    int randInt(int lowest, int highest); // Random int from lowest to highest
+    int randInt(int limit); // Random int from 0 to limit-1
+    bool trueWithProbability(double p); // Return true with probability p
+private:
+    std::uint64_t next(); // Advances the engine and returns the next 64 random bits
+
+    std::uint64_t m_seed; // The Random's starting seed
+    std::uint64_t m_state; // The Random's engine state
+};
+
+#endif // RANDOM_INCLUDED
\ No newline at end of file
@@ -0,0 +1,220 @@
+// Renderer.cpp
+
+#include "Renderer.h"
+#include "utilities.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif
+
+// Unchanged cells between two changed runs are resent when there are fewer than this many
+const int RUNGAP = 4;
+
+// Private Helper Function: Determines whether the terminal understands ANSI cursor movement
+static bool detectAnsi()
+{
+#ifdef _MSC_VER
+    // Windows consoles must be asked to interpret escape sequences
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+
+    if (hConsole == INVALID_HANDLE_VALUE || !GetConsoleMode(hConsole, &mode))
+    {
+        return(false);
+    }
+
+    return(SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0);
+#else
+    const char* term = std::getenv("TERM");
+    return(term != nullptr && std::strcmp(term, "dumb") != 0);
+#endif
+}
+
+// Renderer constructor with parameter output stream
+Renderer::Renderer(std::ostream& out)
+    : Renderer(out, detectAnsi())
+{
+}
+
+// Renderer constructor with parameters output stream and ANSI support
+Renderer::Renderer(std::ostream& out, bool ansi)
+    : m_out(out)
+{
+    m_ansi = ansi;
+    m_valid = false; // Nothing has been drawn yet
+    m_cursorRow = 0;
+    m_cursorCol = 0;
+    m_bytesWritten = 0;
+}
+
+// Accessor: returns the number of bytes the Renderer has sent
+long long Renderer::getBytesWritten() const
+{
+    return(m_bytesWritten);
+}
+
+// Mutator: draws the frame, sending only the cells that differ from the previous frame
+void Renderer::present(const std::string& frame)
+{
+    m_buffer.clear();
+
+    // Without cursor addressing, clear the screen and write the frame in full
+    if (!m_ansi)
+    {
+        clearScreen();
+        m_out.write(frame.data(), frame.size());
+        m_out.flush();
+        m_bytesWritten += frame.size();
+        return;
+    }
+
+    // Split the frame into lines, reusing the line buffers from earlier frames
+    size_t lineCount = 0;
+    size_t start = 0;
+
+    while (start < frame.size())
+    {
+        size_t end = frame.find('\n', start);
+
+        if (end == std::string::npos)
+        {
+            end = frame.size();
+        }
+
+        if (lineCount == m_nextLines.size())
+        {
+            m_nextLines.push_back(std::string());
+        }
+
+        m_nextLines[lineCount].assign(frame, start, end - start);
+        lineCount++;
+        start = end + 1;
+    }
+
+    if (!m_valid)
+    {
+        // Draw the whole frame on a cleared screen
+        m_buffer += "\x1B[H\x1B[2J";
+
+        for (size_t r = 0; r < lineCount; r++)
+        {
+            m_buffer += m_nextLines[r];
+            m_buffer += '\n';
+        }
+
+        m_cursorRow = static_cast<int>(lineCount);
+        m_cursorCol = 0;
+    }
+    else
+    {
+        // Send the runs of cells that changed on each line
+        const std::string empty;
+
+        for (size_t r = 0; r < lineCount; r++)
+        {
+            const std::string& next = m_nextLines[r];
+            const std::string& prev = (r < m_lines.size()) ? m_lines[r] : empty;
+            int row = static_cast<int>(r);
+
+            if (prev == next)
+            {
+                continue; // Most lines do not change from one turn to the next
+            }
+
+            int runFirst = -1;
+            int runLast = -1;
+
+            for (int c = 0; c < static_cast<int>(next.size()); c++)
+            {
+                if (c < static_cast<int>(prev.size()) && prev[c] == next[c])
+                {
+                    continue; // The cell is unchanged
+                }
+
+                if (runFirst != -1 && c - runLast > RUNGAP)
+                {
+                    // The gap is too wide to bridge, so finish the current run
+                    moveCursor(row, runFirst);
+                    appendRun(next, runFirst, runLast);
+                    runFirst = -1;
+                }
+
+                if (runFirst == -1)
+                {
+                    runFirst = c;
+                }
+                runLast = c;
+            }
+
+            if (runFirst != -1)
+            {
+                moveCursor(row, runFirst);
+                appendRun(next, runFirst, runLast);
+            }
+
+            // Erase whatever the previous line had past the end of this one
+            if (prev.size() > next.size())
+            {
+                moveCursor(row, static_cast<int>(next.size()));
+                m_buffer += "\x1B[K";
+            }
+        }
+
+        // Erase the lines the previous frame had past the end of this one
+        for (size_t r = lineCount; r < m_lines.size(); r++)
+        {
+            if (!m_lines[r].empty())
+            {
+                moveCursor(static_cast<int>(r), 0);
+                m_buffer += "\x1B[K";
+            }
+        }
+
+        // Leave the cursor below the frame, where a full draw would have left it
+        moveCursor(static_cast<int>(lineCount), 0);
+    }
+
+    // Remember this frame for the next comparison
+    m_nextLines.resize(lineCount);
+    m_lines.swap(m_nextLines);
+    m_valid = true;
+
+    // Send the frame's output in a single write
+    m_out.write(m_buffer.data(), m_buffer.size());
+    m_out.flush();
+    m_bytesWritten += m_buffer.size();
+}
+
+// Mutator: forgets the previous frame, so that the next one is drawn in full
+void Renderer::invalidate()
+{
+    m_valid = false;
+}
+
+// Private Helper Function: appends a cursor move to (row, col), unless the cursor is there
+void Renderer::moveCursor(int row, int col)
+{
+    if (row == m_cursorRow && col == m_cursorCol)
+    {
+        return;
+    }
+
+    // ANSI coordinates are 1-based
+    char move[32];
+    int length = std::snprintf(move, sizeof(move), "\x1B[%d;%dH", row + 1, col + 1);
+    m_buffer.append(move, length);
+
+    m_cursorRow = row;
+    m_cursorCol = col;
+}
+
+// Private Helper Function: appends the cells first to last of the text, moving the cursor
+void Renderer::appendRun(const std::string& text, int first, int last)
+{
+    m_buffer.append(text, first, last - first + 1);
+    m_cursorCol = last + 1;
+}
\ No newline at end of file
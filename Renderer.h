@@ -0,0 +1,54 @@
+// Renderer.h
+
+#ifndef RENDERER_INCLUDED
+#define RENDERER_INCLUDED
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*
+ Renderer Design Notes:
+ - Renderer draws whole frames to a terminal. A frame is the complete text of one screen,
+   one line per '\n', built into a single buffer by the Dungeon and the Player.
+ - Instead of clearing the screen and writing every cell again, each frame is compared
+   with the one before it, and only ANSI cursor moves plus the changed runs of cells are
+   sent. Short stretches of unchanged cells inside a run are resent rather than skipped,
+   as a cursor move costs more bytes than a few cells.
+ - All of a frame's output is gathered first and handed to the stream in one write, with
+   a single flush, so slow links see one burst per turn instead of one per row.
+ - Terminals without cursor addressing (TERM unset or "dumb", or a Windows console that
+   refuses virtual terminal mode) fall back to clearing the screen and writing the whole
+   frame, as the Game always did.
+*/
+
+class Renderer
+{
+public:
+    // Constructors and Destructors
+    Renderer(std::ostream& out); // Detects whether the terminal understands ANSI
+    Renderer(std::ostream& out, bool ansi);
+
+    // Accessor Functions
+    long long getBytesWritten() const; // Retrieve the number of bytes sent so far
+
+    // Mutator Functions
+    void present(const std::string& frame); // Draws the frame, sending only what changed
+    void invalidate(); // Forces the next frame to be drawn in full
+private:
+    // Private Helper Functions
+    void moveCursor(int row, int col); // Appends a cursor move, unless already there
+    void appendRun(const std::string& text, int first, int last); // Appends cells
+
+    std::ostream& m_out; // The Renderer's output stream
+    bool m_ansi; // Whether the terminal understands ANSI cursor movement
+    bool m_valid; // Whether the screen still shows the previous frame
+    std::vector<std::string> m_lines; // The lines of the previous frame
+    std::vector<std::string> m_nextLines; // The lines of the frame being drawn
+    std::string m_buffer; // The output gathered for the frame being drawn
+    int m_cursorRow; // The cursor's row once the buffer has been written (0-based)
+    int m_cursorCol; // The cursor's column once the buffer has been written (0-based)
+    long long m_bytesWritten; // The number of bytes sent to the stream
+};
+
+#endif // RENDERER_INCLUDED
\ No newline at end of file
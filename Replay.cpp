@@ -0,0 +1,293 @@
+// Replay.cpp
+
+#include "Replay.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// The number of keys read from the log at a time
+const std::size_t REPLAYBLOCKSIZE = 65536;
+
+// ReplayRecorder default constructor
+ReplayRecorder::ReplayRecorder()
+{
+    m_keys = 0;
+}
+
+// Accessor: returns whether a log is being written
+bool ReplayRecorder::isRecording() const
+{
+    return(m_out.is_open());
+}
+
+// Mutator: starts a new log at the path, from the snapshot (a save file's bytes)
+bool ReplayRecorder::start(const std::string& path, const char* snapshot, std::size_t size)
+{
+    if (m_out.is_open())
+    {
+        m_out.close();
+    }
+    m_out.clear();
+
+    m_path = path;
+    m_keys = 0;
+    m_out.open(path, std::ios::binary | std::ios::trunc);
+
+    ReplayHeader header;
+    header.magic = REPLAYMAGIC;
+    header.version = REPLAYVERSION;
+    header.byteOrder = SAVEBYTEORDER;
+    header.snapshotSize = static_cast<std::uint32_t>(size);
+
+    if (!m_out.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !m_out.write(snapshot, size) || !m_out.flush())
+    {
+        m_out.close();
+        return(false);
+    }
+
+    return(true);
+}
+
+// Mutator: starts the log over, from a new snapshot (e.g. after a load)
+bool ReplayRecorder::restart(const char* snapshot, std::size_t size)
+{
+    return(start(m_path, snapshot, size));
+}
+
+// Mutator: appends the key to the log
+void ReplayRecorder::record(char key)
+{
+    if (m_out.is_open())
+    {
+        m_out.put(key);
+        m_keys++;
+    }
+}
+
+// Mutator: sends the keys recorded so far to the file
+void ReplayRecorder::flush()
+{
+    if (m_out.is_open())
+    {
+        m_out.flush();
+    }
+}
+
+// Mutator: writes the footer, with the hash of the final state, and closes the log
+void ReplayRecorder::finish(std::uint64_t stateHash)
+{
+    if (!m_out.is_open())
+    {
+        return;
+    }
+
+    ReplayFooter footer;
+    footer.magic = REPLAYENDMAGIC;
+    footer.keyCount = m_keys;
+    footer.stateHash = stateHash;
+
+    m_out.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    m_out.close();
+}
+
+// ReplayReader default constructor
+ReplayReader::ReplayReader()
+{
+    m_finished = false;
+    m_footer = ReplayFooter();
+    m_keyCount = 0;
+    m_keysRead = 0;
+    m_next = 0;
+}
+
+// Accessor: returns the Game the log starts from
+const SaveFile& ReplayReader::snapshot() const
+{
+    return(m_snapshot);
+}
+
+// Accessor: returns whether the log has a footer
+bool ReplayReader::isFinished() const
+{
+    return(m_finished);
+}
+
+// Accessor: returns the footer
+const ReplayFooter& ReplayReader::footer() const
+{
+    return(m_footer);
+}
+
+// Accessor: returns the number of keys read so far
+std::uint64_t ReplayReader::getKeysRead() const
+{
+    return(m_keysRead);
+}
+
+// Mutator: reads the header, snapshot and footer, leaving the keys to be streamed
+bool ReplayReader::open(const std::string& path)
+{
+    m_in.open(path, std::ios::binary | std::ios::ate);
+
+    if (!m_in)
+    {
+        return(false);
+    }
+
+    std::uint64_t end = static_cast<std::uint64_t>(m_in.tellg());
+    m_in.seekg(0);
+
+    // The header must be one this version wrote, on a machine of the same byte order
+    ReplayHeader header;
+
+    if (end < sizeof(header) || !m_in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != REPLAYMAGIC || header.version != REPLAYVERSION ||
+        header.byteOrder != SAVEBYTEORDER || header.snapshotSize > end - sizeof(header))
+    {
+        return(false);
+    }
+
+    if (!m_snapshot.open(m_in, header.snapshotSize))
+    {
+        return(false);
+    }
+
+    std::uint64_t start = sizeof(header) + header.snapshotSize;
+    m_keyCount = end - start;
+
+    // A finished log ends in a footer that counts exactly the keys in front of it
+    if (m_keyCount >= sizeof(ReplayFooter))
+    {
+        ReplayFooter footer;
+        m_in.seekg(end - sizeof(footer));
+
+        if (m_in.read(reinterpret_cast<char*>(&footer), sizeof(footer)) &&
+            footer.magic == REPLAYENDMAGIC && footer.keyCount == m_keyCount - sizeof(footer))
+        {
+            m_finished = true;
+            m_footer = footer;
+            m_keyCount = footer.keyCount;
+        }
+    }
+
+    m_in.clear();
+    m_in.seekg(start);
+
+    return(static_cast<bool>(m_in));
+}
+
+// Mutator: returns the next key, or 'q' once the keys run out
+char ReplayReader::nextKey()
+{
+    if (m_next == m_block.size() && !refill())
+    {
+        return('q');
+    }
+
+    m_keysRead++;
+    return(m_block[m_next++]);
+}
+
+// Private Helper Function: reads the next block of keys, returning false if none are left
+bool ReplayReader::refill()
+{
+    std::uint64_t left = m_keyCount - m_keysRead;
+    std::size_t size = static_cast<std::size_t>(std::min<std::uint64_t>(left, REPLAYBLOCKSIZE));
+
+    m_block.resize(size);
+    m_next = 0;
+
+    if (size == 0 || !m_in.read(m_block.data(), size))
+    {
+        m_block.clear();
+        return(false);
+    }
+
+    return(true);
+}
+
+// Accessor: prints how the replay went
+void Replay::printResult(const ReplayResult& result, std::ostream& out)
+{
+    if (!result.opened)
+    {
+        out << "The replay log could not be read." << std::endl;
+        return;
+    }
+
+    const char* outcomes[] = { "won", "died", "quit" };
+    double turnRate = (result.seconds > 0) ? result.turns / result.seconds : 0.0;
+
+    out << "Replayed " << result.keys << " keys (" << result.turns << " turns) in "
+        << result.seconds << "s (" << turnRate << " turns per second)" << std::endl;
+    out << "Outcome: " << outcomes[result.game.outcome] << " on level " << result.game.level
+        << " after " << result.game.turns << " turns" << std::endl;
+    out << "State hash: " << std::hex << std::setw(16) << std::setfill('0')
+        << result.stateHash << std::dec << std::setfill(' ');
+
+    if (!result.finished)
+    {
+        out << " (the recorded Game did not finish, so there is nothing to check)" << std::endl;
+    }
+    else if (result.matched)
+    {
+        out << " (matches the recording)" << std::endl;
+    }
+    else
+    {
+        out << " (DOES NOT match the recording)" << std::endl;
+    }
+}
+
+// Mutator: replays the log headlessly, as fast as it runs, and checks the final state
+ReplayResult Replay::run(const std::string& path)
+{
+    ReplayResult result = ReplayResult();
+    ReplayReader reader;
+
+    if (!reader.open(path))
+    {
+        return(result);
+    }
+
+    result.opened = true;
+    result.finished = reader.isFinished();
+
+    // Start from the snapshot, and keep the replay away from the player's save file
+    // N.B. A load in the recorded Game started the log over, so every load in it failed
+    Game game(0, 0);
+    game.load(reader.snapshot());
+    game.setSaveFile("");
+
+    int startTurns = reader.snapshot().header().turns;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    result.game = game.runHeadless([&reader]() -> char
+    {
+        return(reader.nextKey());
+    });
+
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(stop - start).count();
+    result.turns = result.game.turns - startTurns;
+    result.keys = reader.getKeysRead();
+    result.stateHash = game.stateHash();
+    result.matched = result.finished && result.keys == reader.footer().keyCount &&
+        result.stateHash == reader.footer().stateHash;
+
+    return(result);
+}
+
+#ifdef MINIROGUE_REPLAY
+
+// Usage: replay [log file]
+int main(int argc, char* argv[])
+{
+    ReplayResult result = Replay::run((argc > 1) ? argv[1] : REPLAYFILE);
+    Replay::printResult(result, std::cout);
+
+    return((result.opened && (result.matched || !result.finished)) ? 0 : 1);
+}
+#endif
\ No newline at end of file
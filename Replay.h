@@ -0,0 +1,140 @@
+// Replay.h
+
+#ifndef REPLAY_INCLUDED
+#define REPLAY_INCLUDED
+
+#include "Game.h"
+#include "SaveFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*
+ Replay Design Notes:
+ - A replay log records a Game as it is played, so that it can be run again exactly: a
+   header, a snapshot of the Game when recording began (a whole save file, which holds the
+   seed and the random state), one byte for every key read, and, once the Game is over, a
+   footer with the number of keys and a hash of the final state.
+ - A Game always plays out the same way from the same state and keys, so re-running the
+   keys from the snapshot headlessly reproduces the recorded Game, and the final hash shows
+   whether it did. A log whose Game never finished (e.g. it crashed) has no footer, but is
+   replayed all the same, up to its last key.
+ - When the Game is played at the terminal, each key is flushed as it is recorded, so a
+   crash loses none of them; headless recordings are left buffered. A load during
+   recording starts the log again from the loaded state, so a log never depends on a save
+   file outside of it. The debug key of an instrumented build takes no turn, and is not
+   recorded, so a log replays the same in every build.
+ - The keys are streamed from the file in blocks while the replay runs, so a log of many
+   millions of turns never has to fit in memory.
+ - Replay is not part of the game itself: build it in place of main.cpp with
+   MINIROGUE_REPLAY defined, which supplies a main() that replays a log and checks it.
+*/
+
+// Replay Log Format Constants
+const std::uint32_t REPLAYMAGIC = 0x4C52524D; // "MRRL" in the file, on little-endian machines
+const std::uint32_t REPLAYVERSION = 1; // The version of the layout below
+const std::uint64_t REPLAYENDMAGIC = 0xFF00444E45525200ULL; // Marks the footer
+
+// The log that a Game played at the terminal records to
+const char REPLAYFILE[] = "minirogue.rec";
+
+// The replay log header, which is followed by the snapshot
+struct ReplayHeader
+{
+    std::uint32_t magic; // Always REPLAYMAGIC
+    std::uint32_t version; // The layout version, REPLAYVERSION when written
+    std::uint32_t byteOrder; // SAVEBYTEORDER, as written by the recording machine
+    std::uint32_t snapshotSize; // The size in bytes of the save file that follows
+};
+
+// The replay log footer, written once the recorded Game is over
+struct ReplayFooter
+{
+    std::uint64_t magic; // Always REPLAYENDMAGIC
+    std::uint64_t keyCount; // The number of keys recorded
+    std::uint64_t stateHash; // The hash of the Game's final state
+};
+
+// The outcome of replaying a log
+struct ReplayResult
+{
+    bool opened; // Whether the log could be read
+    bool finished; // Whether the log has a footer to check against
+    bool matched; // Whether the replay ended on the recorded key count and state hash
+    GameResult game; // How the replayed Game ended
+    int turns; // The number of turns replayed (the snapshot's own are not counted)
+    std::uint64_t keys; // The number of keys replayed
+    std::uint64_t stateHash; // The hash of the replayed Game's final state
+    double seconds; // The wall clock time the replay took
+};
+
+// Records a Game's keys to a replay log
+class ReplayRecorder
+{
+public:
+    // Constructors and Destructors
+    ReplayRecorder();
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    // Accessor Functions
+    bool isRecording() const; // Retrieve whether a log is being written
+
+    // Mutator Functions
+    bool start(const std::string& path, const char* snapshot, std::size_t size); // New log
+    bool restart(const char* snapshot, std::size_t size); // Starts the log again
+    void record(char key); // Appends the key to the log
+    void flush(); // Sends the keys recorded so far to the file
+    void finish(std::uint64_t stateHash); // Writes the footer and closes the log
+private:
+    std::string m_path; // The log's file name
+    std::ofstream m_out; // The log being written
+    std::uint64_t m_keys; // The number of keys recorded since the snapshot
+};
+
+// Reads a replay log back, streaming its keys
+class ReplayReader
+{
+public:
+    // Constructors and Destructors
+    ReplayReader();
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    // Accessor Functions
+    const SaveFile& snapshot() const; // Retrieve the Game the log starts from
+    bool isFinished() const; // Retrieve whether the log has a footer
+    const ReplayFooter& footer() const; // Retrieve the footer (valid only if finished)
+    std::uint64_t getKeysRead() const; // Retrieve the number of keys read so far
+
+    // Mutator Functions
+    bool open(const std::string& path); // Reads the header, snapshot and footer
+    char nextKey(); // Retrieves the next key, or 'q' once the keys run out
+private:
+    // Private Helper Functions
+    bool refill(); // Reads the next block of keys
+
+    std::ifstream m_in; // The log being read
+    SaveFile m_snapshot; // The Game the log starts from
+    bool m_finished; // Whether the log has a footer
+    ReplayFooter m_footer; // The log's footer
+    std::uint64_t m_keyCount; // The number of keys in the log
+    std::uint64_t m_keysRead; // The number of keys read so far
+    std::vector<char> m_block; // The block of keys being read
+    std::size_t m_next; // The index in the block of the next key
+};
+
+class Replay
+{
+public:
+    // Accessor Functions
+    static void printResult(const ReplayResult& result, std::ostream& out);
+
+    // Mutator Functions
+    static ReplayResult run(const std::string& path); // Replays the log headlessly
+};
+
+#endif // REPLAY_INCLUDED
\ No newline at end of file
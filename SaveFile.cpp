@@ -0,0 +1,585 @@
+// SaveFile.cpp
+
+#include "SaveFile.h"
+#include "Actor.h"
+#include "Dungeon.h"
+#include "Item.h"
+#include "MessageLog.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// The largest map a save file may describe, in cells
+const long long MAXSAVECELLS = 1 << 24;
+
+// The most Messages a save file may hold
+const int MAXSAVEMESSAGES = 1 << 16;
+
+// Files at least this large are memory-mapped; smaller ones are quicker to read outright
+const std::size_t MAPTHRESHOLD = 65536;
+
+// The most Items the Player's inventory holds
+const int MAXINVENTORY = 26;
+
+// The checksum covers everything after itself, the rest of the header included
+const std::size_t CHECKSUMSTART = offsetof(SaveHeader, checksum) + sizeof(std::uint32_t);
+
+// The record arrays, in the order they follow the header
+const int SECTIONMONSTERS = 0;
+const int SECTIONITEMS = 1;
+const int SECTIONINVENTORY = 2;
+const int SECTIONACTORCELLS = 3;
+const int SECTIONITEMCELLS = 4;
+const int SECTIONMESSAGES = 5;
+const int SECTIONGRID = 6;
+const int SECTIONEND = 7;
+
+// Private Helper Function: Fills in the size in bytes of each record array the header counts
+static void sectionSizes(const SaveHeader& header, std::size_t sizes[SECTIONEND])
+{
+    sizes[SECTIONMONSTERS] = std::size_t(header.monsterCount) * sizeof(SaveActor);
+    sizes[SECTIONITEMS] = std::size_t(header.itemCount) * sizeof(SaveItem);
+    sizes[SECTIONINVENTORY] = std::size_t(header.inventoryCount) * sizeof(SaveItem);
+    sizes[SECTIONACTORCELLS] = std::size_t(header.actorCellCount) * sizeof(std::int32_t);
+    sizes[SECTIONITEMCELLS] = std::size_t(header.itemCellCount) * sizeof(std::int32_t);
+    sizes[SECTIONMESSAGES] = std::size_t(header.messageCount) * sizeof(SaveMessage);
+    sizes[SECTIONGRID] = std::size_t(header.rows) * std::size_t(header.cols);
+}
+
+// Private Helper Function: Returns the checksum of the bytes (their hash, folded in half)
+static std::uint32_t checksum(const char* data, std::size_t size)
+{
+    std::uint64_t hash = SaveFile::hash(data, size);
+    hash ^= hash >> 32;
+    return(static_cast<std::uint32_t>(hash));
+}
+
+// Private Helper Function: Returns whether the value lies from lowest to highest inclusive
+static bool inRange(std::int32_t value, int lowest, int highest)
+{
+    return(value >= lowest && value <= highest);
+}
+
+// SaveFile default constructor
+SaveFile::SaveFile()
+{
+    m_data = nullptr;
+    m_size = 0;
+    m_mapping = nullptr;
+}
+
+// SaveFile destructor
+SaveFile::~SaveFile()
+{
+    close();
+}
+
+// Accessor: returns the header
+const SaveHeader& SaveFile::header() const
+{
+    return(*reinterpret_cast<const SaveHeader*>(m_data));
+}
+
+// Accessor: returns the monster records
+const SaveActor* SaveFile::monsters() const
+{
+    return(reinterpret_cast<const SaveActor*>(section(SECTIONMONSTERS)));
+}
+
+// Accessor: returns the floor Item records
+const SaveItem* SaveFile::items() const
+{
+    return(reinterpret_cast<const SaveItem*>(section(SECTIONITEMS)));
+}
+
+// Accessor: returns the inventory Item records
+const SaveItem* SaveFile::inventory() const
+{
+    return(reinterpret_cast<const SaveItem*>(section(SECTIONINVENTORY)));
+}
+
+// Accessor: returns the cells an Actor may be placed on, in sampling order
+const std::int32_t* SaveFile::actorCells() const
+{
+    return(reinterpret_cast<const std::int32_t*>(section(SECTIONACTORCELLS)));
+}
+
+// Accessor: returns the cells an Item may be placed on, in sampling order
+const std::int32_t* SaveFile::itemCells() const
+{
+    return(reinterpret_cast<const std::int32_t*>(section(SECTIONITEMCELLS)));
+}
+
+// Accessor: returns the Message records, oldest first
+const SaveMessage* SaveFile::messages() const
+{
+    return(reinterpret_cast<const SaveMessage*>(section(SECTIONMESSAGES)));
+}
+
+// Accessor: returns the cell statuses, row by row
+const std::uint8_t* SaveFile::grid() const
+{
+    return(reinterpret_cast<const std::uint8_t*>(section(SECTIONGRID)));
+}
+
+// Accessor: returns the file's bytes
+const char* SaveFile::data() const
+{
+    return(m_data);
+}
+
+// Accessor: returns the file's size in bytes
+std::size_t SaveFile::size() const
+{
+    return(m_size);
+}
+
+// Accessor: returns a 64-bit hash of the bytes
+std::uint64_t SaveFile::hash(const char* data, std::size_t size)
+{
+    // Mix in eight bytes at a time (the multipliers are SplitMix64's), then the last few
+    std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ size;
+    std::size_t i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+        hash ^= hash >> 31;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x94D049BB133111EBULL;
+    }
+
+    return(hash);
+}
+
+// Mutator: maps (or reads) the file and checks it, returning false if it cannot be used
+bool SaveFile::open(const std::string& path)
+{
+    close();
+
+#ifndef _MSC_VER
+    int file = ::open(path.c_str(), O_RDONLY);
+
+    if (file == -1)
+    {
+        return(false);
+    }
+
+    struct stat info;
+
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        std::size_t size = info.st_size;
+
+        if (size >= MAPTHRESHOLD)
+        {
+            // Map a large file, so that the records are read straight from the page cache
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (mapping != MAP_FAILED)
+            {
+                m_mapping = mapping;
+                m_data = static_cast<const char*>(mapping);
+                m_size = size;
+            }
+        }
+        else
+        {
+            // Setting up a mapping costs more than reading a small file
+            m_buffer.resize(size);
+
+            if (::read(file, m_buffer.data(), size) == static_cast<ssize_t>(size))
+            {
+                m_data = m_buffer.data();
+                m_size = size;
+            }
+        }
+    }
+
+    ::close(file);
+#endif
+
+    // Otherwise, read the whole file into memory in one call
+    if (m_data == nullptr)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+
+        if (!in)
+        {
+            return(false);
+        }
+
+        std::streamoff size = in.tellg();
+        m_buffer.resize(size > 0 ? static_cast<std::size_t>(size) : 0);
+        in.seekg(0);
+
+        if (!in.read(m_buffer.data(), m_buffer.size()))
+        {
+            m_buffer.clear();
+            return(false);
+        }
+
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    // Refuse anything that does not describe a possible Game
+    if (!validate())
+    {
+        close();
+        return(false);
+    }
+
+    return(true);
+}
+
+// Mutator: reads a save file of the given size from the stream and checks it
+bool SaveFile::open(std::istream& in, std::size_t size)
+{
+    close();
+
+    m_buffer.resize(size);
+
+    if (size == 0 || !in.read(m_buffer.data(), size))
+    {
+        m_buffer.clear();
+        return(false);
+    }
+
+    m_data = m_buffer.data();
+    m_size = size;
+
+    // Refuse anything that does not describe a possible Game
+    if (!validate())
+    {
+        close();
+        return(false);
+    }
+
+    return(true);
+}
+
+// Mutator: releases the file's mapping or buffer
+void SaveFile::close()
+{
+#ifndef _MSC_VER
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, m_size);
+    }
+#endif
+
+    m_mapping = nullptr;
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// Mutator: fills in the counts and checksum, and lays the save file out in the bytes
+void SaveFile::serialize(SaveData& data, std::vector<char>& bytes)
+{
+    SaveHeader& header = data.header;
+    header.magic = SAVEMAGIC;
+    header.version = SAVEVERSION;
+    header.byteOrder = SAVEBYTEORDER;
+    header.reserved = 0;
+    header.monsterCount = data.monsters.size();
+    header.itemCount = data.items.size();
+    header.inventoryCount = data.inventory.size();
+    header.actorCellCount = data.actorCells.size();
+    header.itemCellCount = data.itemCells.size();
+    header.messageCount = data.messages.size();
+
+    // Lay the record arrays out one after another, behind the header
+    std::size_t sizes[SECTIONEND];
+    sectionSizes(header, sizes);
+
+    const void* sources[SECTIONEND] = { data.monsters.data(), data.items.data(),
+        data.inventory.data(), data.actorCells.data(), data.itemCells.data(),
+        data.messages.data(), data.grid.data() };
+
+    std::size_t total = sizeof(SaveHeader);
+    for (int s = 0; s < SECTIONEND; s++)
+    {
+        total += sizes[s];
+    }
+
+    bytes.assign(sizeof(SaveHeader), 0);
+    bytes.reserve(total);
+    for (int s = 0; s < SECTIONEND; s++)
+    {
+        if (sizes[s] > 0)
+        {
+            const char* source = static_cast<const char*>(sources[s]);
+            bytes.insert(bytes.end(), source, source + sizes[s]);
+        }
+    }
+
+    std::memcpy(bytes.data(), &header, sizeof(SaveHeader));
+    header.checksum = checksum(bytes.data() + CHECKSUMSTART, bytes.size() - CHECKSUMSTART);
+    std::memcpy(bytes.data() + offsetof(SaveHeader, checksum), &header.checksum,
+        sizeof(header.checksum));
+}
+
+// Mutator: writes the save file in one piece
+bool SaveFile::write(const std::string& path, SaveData& data)
+{
+    std::vector<char> bytes;
+    serialize(data, bytes);
+
+    // Write beside the old file, then replace it, so a failed save never loses the last one
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+
+        if (!out.write(bytes.data(), bytes.size()) || !out.flush())
+        {
+            out.close();
+            std::remove(temporary.c_str());
+            return(false);
+        }
+    }
+
+    // N.B. Windows will not rename over an existing file, so the old one is removed first
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::remove(path.c_str());
+
+        if (std::rename(temporary.c_str(), path.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+// Private Helper Function: Returns whether the file describes a Game the Dungeon can load
+bool SaveFile::validate() const
+{
+    if (m_size < sizeof(SaveHeader))
+    {
+        return(false);
+    }
+
+    const SaveHeader& h = header();
+
+    // The header must be one this version wrote, on a machine of the same byte order
+    if (h.magic != SAVEMAGIC || h.version != SAVEVERSION || h.byteOrder != SAVEBYTEORDER ||
+        h.reserved != 0)
+    {
+        return(false);
+    }
+
+    // The dimensions and counts must be in range before any sizes are worked out
+    if (h.rows < DUNGEONROWS || h.cols < DUNGEONCOLS ||
+        static_cast<long long>(h.rows) * h.cols > MAXSAVECELLS)
+    {
+        return(false);
+    }
+
+    int cells = h.rows * h.cols;
+
+    if (!inRange(h.level, 0, IDOLLEVEL) || !inRange(h.monsterCount, 0, cells) ||
+        !inRange(h.itemCount, 0, cells) || !inRange(h.inventoryCount, 1, MAXINVENTORY) ||
+        !inRange(h.actorCellCount, 0, cells) || !inRange(h.itemCellCount, 0, cells) ||
+        !inRange(h.messageCount, 0, MAXSAVEMESSAGES) ||
+        !inRange(h.playerMessages, 0, h.messageCount) ||
+        !inRange(h.monsterMessages, 0, h.messageCount) ||
+        !inRange(h.weaponIndex, 0, h.inventoryCount - 1) || h.turns < 0)
+    {
+        return(false);
+    }
+
+    // The file must hold exactly the records the header counts, unchanged since saving
+    std::size_t sizes[SECTIONEND];
+    sectionSizes(h, sizes);
+
+    std::size_t expected = sizeof(SaveHeader);
+    for (int s = 0; s < SECTIONEND; s++)
+    {
+        expected += sizes[s];
+    }
+
+    if (m_size != expected ||
+        checksum(m_data + CHECKSUMSTART, m_size - CHECKSUMSTART) != h.checksum)
+    {
+        return(false);
+    }
+
+    // Every cell must hold a known status, and the placement sets must match the grid
+    const std::uint8_t* status = grid();
+    int actorCellsExpected = 0;
+    int itemCellsExpected = 0;
+    int actorsExpected = 0;
+    int itemsExpected = 0;
+
+    for (int i = 0; i < cells; i++)
+    {
+        switch (status[i])
+        {
+            case EMPTY:
+                actorCellsExpected++;
+                itemCellsExpected++;
+                break;
+            case ACTOR:
+                itemCellsExpected++;
+                actorsExpected++;
+                break;
+            case ITEM:
+                actorCellsExpected++;
+                itemsExpected++;
+                break;
+            case ACTORITEM:
+                actorsExpected++;
+                itemsExpected++;
+                break;
+            case WALLS:
+                break;
+            default:
+                return(false);
+        }
+    }
+
+    if (h.actorCellCount != actorCellsExpected || h.itemCellCount != itemCellsExpected ||
+        h.monsterCount + 1 != actorsExpected || h.itemCount != itemsExpected)
+    {
+        return(false);
+    }
+
+    // Each cell may appear once per set, and may hold one Actor and one Item
+    std::vector<unsigned char> seen(cells, 0);
+    const unsigned char SEENACTORCELL = 1, SEENITEMCELL = 2, SEENACTOR = 4, SEENITEM = 8;
+
+    const std::int32_t* actorCellList = actorCells();
+    for (int i = 0; i < h.actorCellCount; i++)
+    {
+        std::int32_t cell = actorCellList[i];
+
+        if (!inRange(cell, 0, cells - 1) || (seen[cell] & SEENACTORCELL) ||
+            (status[cell] != EMPTY && status[cell] != ITEM))
+        {
+            return(false);
+        }
+        seen[cell] |= SEENACTORCELL;
+    }
+
+    const std::int32_t* itemCellList = itemCells();
+    for (int i = 0; i < h.itemCellCount; i++)
+    {
+        std::int32_t cell = itemCellList[i];
+
+        if (!inRange(cell, 0, cells - 1) || (seen[cell] & SEENITEMCELL) ||
+            (status[cell] != EMPTY && status[cell] != ACTOR))
+        {
+            return(false);
+        }
+        seen[cell] |= SEENITEMCELL;
+    }
+
+    // Every Actor must stand, alone, on a cell marked as holding an Actor
+    const SaveActor* monsterList = monsters();
+    for (int i = 0; i <= h.monsterCount; i++)
+    {
+        const SaveActor& actor = (i < h.monsterCount) ? monsterList[i] : h.player;
+        ActorKind lowest = (i < h.monsterCount) ? ActorKind::Goblin : ActorKind::Player;
+        ActorKind highest = (i < h.monsterCount) ? ActorKind::Dragon : ActorKind::Player;
+
+        if (!inRange(actor.kind, static_cast<int>(lowest), static_cast<int>(highest)) ||
+            !inRange(actor.row, 0, h.rows - 1) || !inRange(actor.col, 0, h.cols - 1))
+        {
+            return(false);
+        }
+
+        int cell = actor.row * h.cols + actor.col;
+
+        if ((seen[cell] & SEENACTOR) || (status[cell] != ACTOR && status[cell] != ACTORITEM))
+        {
+            return(false);
+        }
+        seen[cell] |= SEENACTOR;
+    }
+
+    // Every floor Item must lie, alone, on a cell marked as holding an Item
+    const SaveItem* itemList = items();
+    for (int i = 0; i < h.itemCount; i++)
+    {
+        const SaveItem& item = itemList[i];
+
+        if (!inRange(item.kind, static_cast<int>(ItemKind::Mace),
+            static_cast<int>(ItemKind::GoldenIdol)) ||
+            !inRange(item.row, 0, h.rows - 1) || !inRange(item.col, 0, h.cols - 1))
+        {
+            return(false);
+        }
+
+        int cell = item.row * h.cols + item.col;
+
+        if ((seen[cell] & SEENITEM) || (status[cell] != ITEM && status[cell] != ACTORITEM))
+        {
+            return(false);
+        }
+        seen[cell] |= SEENITEM;
+    }
+
+    // The Player only ever carries Weapons and Scrolls
+    const SaveItem* inventoryList = inventory();
+    for (int i = 0; i < h.inventoryCount; i++)
+    {
+        if (!inRange(inventoryList[i].kind, static_cast<int>(ItemKind::Mace),
+            static_cast<int>(ItemKind::EnhanceDexterity)))
+        {
+            return(false);
+        }
+    }
+
+    // The Player always carries a Weapon, and wields it from the inventory
+    if (!inRange(inventoryList[h.weaponIndex].kind, static_cast<int>(ItemKind::Mace),
+        static_cast<int>(ItemKind::MagicFangs)))
+    {
+        return(false);
+    }
+
+    // Every Message must name a known Message, Actor kind and Item kind
+    const SaveMessage* messageList = messages();
+    for (int i = 0; i < h.messageCount; i++)
+    {
+        const SaveMessage& message = messageList[i];
+
+        if (!inRange(message.id, 0, static_cast<int>(MessageId::MonsterKills)) ||
+            !inRange(message.actor, 0, static_cast<int>(ActorKind::Dragon)) ||
+            !inRange(message.item, 0, static_cast<int>(ItemKind::GoldenIdol)))
+        {
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+// Private Helper Function: Returns the start of the index-th record array
+const char* SaveFile::section(int index) const
+{
+    std::size_t sizes[SECTIONEND];
+    sectionSizes(header(), sizes);
+
+    std::size_t offset = sizeof(SaveHeader);
+    for (int s = 0; s < index; s++)
+    {
+        offset += sizes[s];
+    }
+
+    return(m_data + offset);
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+// SaveFile.h
+
+#ifndef SAVEFILE_INCLUDED
+#define SAVEFILE_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*
+ SaveFile Design Notes:
+ - A save file holds the full state of a Game: the grid, the Player with its statistics
+   and inventory, the monsters with their statistics and sleep timers, the Items on the
+   floor, the level, the random number state, the placement sets and the Message history.
+ - The format is binary and fixed-layout: a header of counts, then one array per kind of
+   record, then the grid at one byte per cell. Every record is a run of 32-bit integers,
+   in the byte order of the machine that saved it (the header records it), so loading is
+   a size check and a checksum rather than parsing; the Dungeon reads the records in place.
+ - Where the system supports it, a large file (e.g. of a big map) is memory-mapped rather
+   than read, so its load costs no copy at all. Smaller files, and every file elsewhere,
+   are read into a buffer in a single call, which is quicker than setting up a mapping.
+ - The version is bumped whenever the layout changes, and older versions are refused
+   rather than misread. A file is also refused if its sizes, checksum or contents do not
+   describe a possible Game (e.g. an Actor standing in a wall), so a damaged file never
+   reaches the Dungeon.
+ - A save file may also be read from the middle of a stream (e.g. the snapshot a replay
+   log starts from), and the laid out bytes hash the whole state of a Game in one pass.
+ - The placement sets are saved in their sampling order, so that a loaded Game plays on
+   exactly as the saved one would have.
+*/
+
+// Save File Format Constants
+const std::uint32_t SAVEMAGIC = 0x5653524D; // "MRSV" in the file, on little-endian machines
+const std::uint32_t SAVEVERSION = 1; // The version of the layout below
+const std::uint32_t SAVEBYTEORDER = 0x01020304; // Reads back differently on other machines
+
+// An Actor's record (the Player's or a monster's)
+struct SaveActor
+{
+    std::int32_t kind; // The Actor's ActorKind
+    std::int32_t row; // The Actor's row coordinate
+    std::int32_t col; // The Actor's column coordinate
+    std::int32_t hp; // The Actor's hit points
+    std::int32_t maxHP; // The Actor's maximum hit points
+    std::int32_t sleep; // The Actor's sleep time
+    std::int32_t dexterity; // The Actor's dexterity points
+    std::int32_t strength; // The Actor's strength points
+    std::int32_t armor; // The Actor's armor points
+    std::int32_t reach; // How far away the Actor notices the Player
+};
+
+// An Item's record (on the floor, or in the Player's inventory)
+struct SaveItem
+{
+    std::int32_t kind; // The Item's ItemKind
+    std::int32_t row; // The Item's row coordinate
+    std::int32_t col; // The Item's column coordinate
+    std::int32_t bonus; // The Scroll's rolled bonus (zero for other Items)
+};
+
+// A Message's record
+struct SaveMessage
+{
+    std::int32_t id; // The Message's MessageId
+    std::int32_t actor; // The Message's ActorKind
+    std::int32_t item; // The Message's ItemKind
+    std::int32_t amount; // The Message's amount
+};
+
+// The save file header, which also holds the Game's scalar state
+struct SaveHeader
+{
+    std::uint32_t magic; // Always SAVEMAGIC
+    std::uint32_t version; // The layout version, SAVEVERSION when written
+    std::uint32_t byteOrder; // SAVEBYTEORDER, as written by the saving machine
+    std::uint32_t checksum; // The checksum of everything after this field
+    std::uint64_t seed; // The Game's seed
+    std::uint64_t randomState; // The Dungeon's random engine state
+    std::int32_t rows; // The Dungeon's row dimension
+    std::int32_t cols; // The Dungeon's column dimension
+    std::int32_t level; // The Dungeon's level
+    std::int32_t smellDistance; // The Dungeon's Goblin smell distance
+    std::int32_t turns; // The number of turns the Player has taken
+    std::int32_t cheated; // Whether the Player has already cheated
+    std::int32_t winner; // Whether the Player has won
+    std::int32_t dead; // Whether the Player has died
+    std::int32_t weaponIndex; // The index of the Player's wielded Weapon
+    std::int32_t monsterCount; // The number of monster records
+    std::int32_t itemCount; // The number of floor Item records
+    std::int32_t inventoryCount; // The number of inventory Item records
+    std::int32_t actorCellCount; // The number of cells an Actor may be placed on
+    std::int32_t itemCellCount; // The number of cells an Item may be placed on
+    std::int32_t messageCount; // The number of Message records, oldest first
+    std::int32_t playerMessages; // How many of them were posted in the Player's turn
+    std::int32_t monsterMessages; // How many of them were posted in the monsters' turn
+    std::int32_t reserved; // Always zero; pads the header to a multiple of 8 bytes
+    SaveActor player; // The Player's record
+};
+
+// The contents of a save file, gathered before it is written
+struct SaveData
+{
+    SaveHeader header; // The header (the counts and checksum are filled in on writing)
+    std::vector<SaveActor> monsters; // The monsters, in the Dungeon's order
+    std::vector<SaveItem> items; // The floor Items, in the Dungeon's order
+    std::vector<SaveItem> inventory; // The Player's inventory, in order
+    std::vector<std::int32_t> actorCells; // The cells an Actor may be placed on, in order
+    std::vector<std::int32_t> itemCells; // The cells an Item may be placed on, in order
+    std::vector<SaveMessage> messages; // The Message history, oldest first
+    std::vector<std::uint8_t> grid; // The Dungeon's cell statuses, row by row
+};
+
+class SaveFile
+{
+public:
+    // Constructors and Destructors
+    SaveFile();
+    ~SaveFile();
+    SaveFile(const SaveFile&) = delete;
+    SaveFile& operator=(const SaveFile&) = delete;
+
+    // Accessor Functions (valid only once a file is open)
+    const SaveHeader& header() const; // Retrieve the header
+    const SaveActor* monsters() const; // Retrieve the monster records
+    const SaveItem* items() const; // Retrieve the floor Item records
+    const SaveItem* inventory() const; // Retrieve the inventory Item records
+    const std::int32_t* actorCells() const; // Retrieve the cells an Actor may be placed on
+    const std::int32_t* itemCells() const; // Retrieve the cells an Item may be placed on
+    const SaveMessage* messages() const; // Retrieve the Message records
+    const std::uint8_t* grid() const; // Retrieve the cell statuses
+    const char* data() const; // Retrieve the file's bytes
+    std::size_t size() const; // Retrieve the file's size in bytes
+    static std::uint64_t hash(const char* data, std::size_t size); // Hashes the bytes
+
+    // Mutator Functions
+    bool open(const std::string& path); // Maps and checks the file; false if unusable
+    bool open(std::istream& in, std::size_t size); // Reads and checks a file in a stream
+    void close(); // Releases the file
+    static void serialize(SaveData& data, std::vector<char>& bytes); // Lays out a save file
+    static bool write(const std::string& path, SaveData& data); // Writes a save file
+private:
+    // Private Helper Functions
+    bool validate() const; // Checks that the file describes a possible Game
+    const char* section(int index) const; // The start of the index-th record array
+
+    const char* m_data; // The file's bytes, or nullptr if no file is open
+    std::size_t m_size; // The file's size in bytes
+    void* m_mapping; // The memory mapping of the file, if it was mapped
+    std::vector<char> m_buffer; // The file's bytes, if it was read instead
+};
+
+#endif // SAVEFILE_INCLUDED
\ No newline at end of file
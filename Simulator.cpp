@@ -0,0 +1,228 @@
+// Simulator.cpp
+
+#include "Game.h"
+#include "Random.h"
+#include "Simulator.h"
+#include "utilities.h"
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// A worker's deque of Game seeds, guarded by its own lock
+struct TaskQueue
+{
+    std::mutex lock;
+    std::deque<std::uint64_t> seeds;
+};
+
+// Simulator constructor with parameters Goblin smell distance and turn limit
+Simulator::Simulator(int smellDistance, int maxTurns)
+{
+    m_smellDistance = smellDistance;
+    m_maxTurns = maxTurns;
+}
+
+// Accessor: prints the win rate, death levels and throughput of a batch
+void Simulator::printReport(const SimulationReport& report, std::ostream& out)
+{
+    double winRate = (report.games > 0) ? 100.0 * report.wins / report.games : 0.0;
+    double turnRate = (report.seconds > 0) ? report.turns / report.seconds : 0.0;
+
+    out << "Games: " << report.games << ", Wins: " << report.wins << " (" << winRate
+        << "%), Deaths: " << report.deaths << ", Quits: " << report.quits << std::endl;
+
+    for (size_t level = 0; level < report.deathLevels.size(); level++)
+    {
+        out << "Deaths on level " << level << ": " << report.deathLevels[level] << std::endl;
+    }
+
+    out << "Turns: " << report.turns << " in " << report.seconds << "s ("
+        << turnRate << " turns per second)" << std::endl;
+}
+
+// Mutator: plays a batch of Games with consecutive seeds across the given threads
+SimulationReport Simulator::run(std::uint64_t firstSeed, int games, int threads)
+{
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+
+    // Deal the Games out round robin; stealing evens out whatever imbalance remains
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    for (int t = 0; t < threads; t++)
+    {
+        queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue));
+    }
+    for (int g = 0; g < games; g++)
+    {
+        queues[g % threads]->seeds.push_back(firstSeed + g);
+    }
+
+    std::vector<SimulationReport> parts(threads, SimulationReport());
+    std::vector<std::thread> workers;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < threads; t++)
+    {
+        workers.push_back(std::thread([this, t, threads, &queues, &parts]()
+        {
+            while (true)
+            {
+                std::uint64_t seed = 0;
+                bool found = false;
+
+                // Take the newest task from our own deque
+                {
+                    std::lock_guard<std::mutex> guard(queues[t]->lock);
+                    if (!queues[t]->seeds.empty())
+                    {
+                        seed = queues[t]->seeds.back();
+                        queues[t]->seeds.pop_back();
+                        found = true;
+                    }
+                }
+
+                // Otherwise, steal the oldest task from the next worker that has one
+                for (int i = 1; i < threads && !found; i++)
+                {
+                    TaskQueue& victim = *queues[(t + i) % threads];
+                    std::lock_guard<std::mutex> guard(victim.lock);
+                    if (!victim.seeds.empty())
+                    {
+                        seed = victim.seeds.front();
+                        victim.seeds.pop_front();
+                        found = true;
+                    }
+                }
+
+                // No task is left anywhere (tasks are never added), so this worker is done
+                if (!found)
+                {
+                    break;
+                }
+
+                playGame(seed, parts[t]);
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+
+    // Merge the per-worker results
+    SimulationReport total = SimulationReport();
+    for (size_t t = 0; t < parts.size(); t++)
+    {
+        merge(total, parts[t]);
+    }
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return(total);
+}
+
+// Accessor: returns the seeded bot's keys, which wander (picking things up and taking
+// stairways too, if it explores) until keysLeft runs out, then quit
+// N.B. The bot draws only from its own Random, so a Game's seed alone fixes how it plays
+std::function<char()> Simulator::botKeys(Random& bot, int& keysLeft, bool cheatFirst,
+    bool explore)
+{
+    bool cheat = cheatFirst; // Whether the next key is the cheat, without a draw
+
+    return([&bot, &keysLeft, cheat, explore]() mutable -> char
+    {
+        const char keys[] = { ARROW_LEFT, ARROW_RIGHT, ARROW_UP, ARROW_DOWN, 'g', '>' };
+
+        if (keysLeft-- <= 0)
+        {
+            return('q');
+        }
+
+        if (cheat)
+        {
+            cheat = false;
+            return('c');
+        }
+
+        return(keys[bot.randInt(explore ? 6 : 4)]);
+    });
+}
+
+// Private Helper Function: plays one Game and records its outcome
+void Simulator::playGame(std::uint64_t seed, SimulationReport& report) const
+{
+    Game game(m_smellDistance, seed);
+    Random bot(~seed); // The bot draws from its own sequence, separate from the Game's
+    int keysLeft = m_maxTurns;
+
+    // Wander at random, picking things up and taking stairways along the way
+    GameResult result = game.runHeadless(botKeys(bot, keysLeft, false));
+
+    report.games++;
+    report.turns += result.turns;
+
+    if (result.outcome == GAME_WON)
+    {
+        report.wins++;
+    }
+    else if (result.outcome == GAME_DIED)
+    {
+        report.deaths++;
+
+        if (report.deathLevels.size() <= static_cast<size_t>(result.level))
+        {
+            report.deathLevels.resize(result.level + 1, 0);
+        }
+        report.deathLevels[result.level]++;
+    }
+    else
+    {
+        report.quits++;
+    }
+}
+
+// Private Helper Function: adds one report's counts into another
+void Simulator::merge(SimulationReport& total, const SimulationReport& part)
+{
+    total.games += part.games;
+    total.wins += part.wins;
+    total.deaths += part.deaths;
+    total.quits += part.quits;
+    total.turns += part.turns;
+
+    if (total.deathLevels.size() < part.deathLevels.size())
+    {
+        total.deathLevels.resize(part.deathLevels.size(), 0);
+    }
+    for (size_t level = 0; level < part.deathLevels.size(); level++)
+    {
+        total.deathLevels[level] += part.deathLevels[level];
+    }
+}
+
+#ifdef MINIROGUE_SIMULATOR
+#include "Instrument.h"
+#include <cstdlib>
+
+// Usage: simulator [games] [threads] [first seed] [smell distance] [turn limit]
+int main(int argc, char* argv[])
+{
+    int games = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    int threads = (argc > 2) ? std::atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    std::uint64_t seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1;
+    int smell = (argc > 4) ? std::atoi(argv[4]) : 15;
+    int maxTurns = (argc > 5) ? std::atoi(argv[5]) : 5000;
+
+    Simulator simulator(smell, maxTurns);
+    Simulator::printReport(simulator.run(seed, games, threads), std::cout);
+
+#ifdef MINIROGUE_INSTRUMENT
+    Instrument::report(std::cout); // Every thread's allocations, by phase
+#endif
+}
+#endif
\ No newline at end of file
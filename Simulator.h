@@ -0,0 +1,63 @@
+// Simulator.h
+
+#ifndef SIMULATOR_INCLUDED
+#define SIMULATOR_INCLUDED
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
+/*
+ Simulator Design Notes:
+ - The Simulator plays many independent, seeded Games headlessly and summarizes how they
+   ended. It is not part of the game itself: build it in place of main.cpp with
+   MINIROGUE_SIMULATOR defined, which supplies a main() that runs a batch and prints it.
+ - Each Game is one task, and each worker thread owns a deque of tasks. Workers take from
+   the back of their own deque and, once it is empty, steal from the front of another
+   worker's. Game lengths vary wildly (a run may die on level 0 or reach the golden idol),
+   so stealing keeps every core busy until the batch is done.
+ - Every worker keeps its own SimulationReport, and these are merged once all workers have
+   finished, so the Games themselves never share any state.
+ - The Player is driven by a simple seeded bot that wanders, picks up whatever it stands
+   on and takes any stairway it finds. Games that run past the turn limit count as quits.
+   The benchmarks drive their Games with the same bot (see botKeys()).
+*/
+
+class Random; // Indicates to compiler that Random is a class
+
+// The combined results of a batch of Games
+struct SimulationReport
+{
+    int games; // The number of Games played
+    int wins; // The number of Games won
+    int deaths; // The number of Games in which the Player died
+    int quits; // The number of Games that hit the turn limit
+    long long turns; // The total number of Player turns across all Games
+    double seconds; // The wall clock time the batch took
+    std::vector<int> deathLevels; // The number of deaths on each Dungeon level
+};
+
+class Simulator
+{
+public:
+    // Constructors and Destructors
+    Simulator(int smellDistance, int maxTurns);
+
+    // Accessor Functions
+    static void printReport(const SimulationReport& report, std::ostream& out);
+    static std::function<char()> botKeys(Random& bot, int& keysLeft, bool cheatFirst,
+        bool explore = true); // Retrieve the seeded bot's keys, as a Game's key source
+
+    // Mutator Functions
+    SimulationReport run(std::uint64_t firstSeed, int games, int threads);
+private:
+    // Private Simulator Helper Functions
+    void playGame(std::uint64_t seed, SimulationReport& report) const;
+    static void merge(SimulationReport& total, const SimulationReport& part);
+
+    int m_smellDistance; // The Goblin smell distance of every Game
+    int m_maxTurns; // The number of turns after which a Game is abandoned
+};
+
+#endif // SIMULATOR_INCLUDED
\ No newline at end of file